@@ -40,6 +40,9 @@ QtBackgroundImage::QtBackgroundImage(const QtSkin& aSkin,
 	setFocusPolicy(Qt::StrongFocus);
 	setFixedSize(pixmap.size());
 	connect(&aKeyboard, SIGNAL(keyPressed()), this, SLOT(updateScreen()));
+	screenTimer.setSingleShot(true);
+	screenTimer.setInterval(SCREEN_REFRESH_INTERVAL);
+	connect(&screenTimer, SIGNAL(timeout()), this, SLOT(refreshScreen()));
 }
 
 void QtBackgroundImage::setSkin(const QtSkin& aSkin)
@@ -342,7 +345,19 @@ void QtBackgroundImage::paintEvent(QPaintEvent* aPaintEvent)
 
 void QtBackgroundImage::updateScreen()
 {
-	update(screen.getScreenRectangle());
+	if(!screenTimer.isActive())
+	{
+		screenTimer.start();
+	}
+}
+
+void QtBackgroundImage::refreshScreen()
+{
+	QRegion region=screen.getChangedRegion();
+	if(!region.isEmpty())
+	{
+		update(region);
+	}
 }
 
 extern "C"
@@ -25,6 +25,8 @@
 
 #define MOVE_MARGIN_X 10
 #define MOVE_MARGIN_Y 10
+// Screen updates are collected and shown at most once per monitor refresh
+#define SCREEN_REFRESH_INTERVAL 16
 
 class QtBackgroundImage: public QLabel
 {
@@ -60,6 +62,7 @@ public:
 
 public slots:
 	void updateScreen();
+	void refreshScreen();
 	void onTrigger(QAction* anAction);
 	void setActiveCatalogMenuItem();
     void onCatalogStateChanged();
@@ -76,6 +79,7 @@ private:
 	 QPixmap pixmap;
 	 QtScreen& screen;
 	 QtKeyboard& keyboard;
+	 QTimer screenTimer;
 	 bool dragging;
 	 QPoint lastDragPosition;
 	 QList<QLabel*> tooltipLabels;
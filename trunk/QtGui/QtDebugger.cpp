@@ -17,11 +17,12 @@
 #include "QtDebugger.h"
 #include "QtRegistersModel.h"
 #include "QtEmulator.h"
+#include "QtEmulatorAdapter.h"
 #include <QScrollBar>
 #include <QHeaderView>
 
 QtDebugger::QtDebugger(QWidget* aParent, bool aDisplayAsStack)
-: QTableView(aParent)
+: QTableView(aParent), lastRefreshTime(0)
 {
 	setModel(new QtRegistersModel(NULL, aDisplayAsStack));
 	setColumnsSizes();
@@ -56,6 +57,8 @@ void QtDebugger::setDisplayAsStack(bool aDisplayAsStack)
 bool QtDebugger::eventFilter(QObject *object, QEvent *event)
 {
 	if(object == this && event->type() == QEvent::Show) {
+		// Catch up with what changed while we were hidden
+		static_cast<QtRegistersModel*>(model())->refresh();
 		setMinimumWidth(minimumSizeHint().width() + verticalScrollBar()->width());
 		if(isDisplayAsStack()) {
 			verticalScrollBar()->setValue(verticalScrollBar()->maximum());
@@ -68,7 +71,14 @@ void QtDebugger::refresh()
 {
 	if(isVisible())
 	{
-		static_cast<QtRegistersModel*>(model())->refresh();
+		qint64 currentTime=QDateTime::currentMSecsSinceEpoch();
+		if(is_running() && currentTime-lastRefreshTime<RUNNING_REFRESH_INTERVAL)
+		{
+			return;
+		}
+		lastRefreshTime=currentTime;
+		// We are called by the calculator thread, the model belongs to the GUI thread
+		QMetaObject::invokeMethod(model(), "refresh", Qt::QueuedConnection);
 	}
 }
 
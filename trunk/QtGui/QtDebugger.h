@@ -20,6 +20,9 @@
 #include <QtGui>
 #include <QTableView>
 
+// How often the registers are refreshed while a program runs, in milliseconds
+#define RUNNING_REFRESH_INTERVAL 250
+
 class QtDebugger: public QTableView
 {
 public:
@@ -36,7 +39,8 @@ public:
 protected:
 	void setColumnsSizes();
 
-protected:
+private:
+	qint64 lastRefreshTime;
 };
 
 #endif /* QTDEBUGGER_H_ */
@@ -843,6 +843,7 @@ void QtEmulator::saveToolsSettings()
 
 void QtEmulator::loadMemory()
 {
+	prepare_memory_load();
 	loadState();
 	loadBackup();
 	loadLibrary();
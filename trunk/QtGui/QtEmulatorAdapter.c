@@ -221,16 +221,25 @@ void prepare_memory_save()
 	checksum_all();
 }
 
+void prepare_memory_load()
+{
+	recover_flash(REGION_BACKUP);
+	recover_flash(REGION_LIBRARY);
+}
+
 void after_state_load()
 {
+	invalidate_label_index(REGION_RAM);
 }
 
 void after_backup_load()
 {
+	invalidate_label_index(REGION_BACKUP);
 }
 
 void after_library_load()
 {
+	invalidate_label_index(REGION_LIBRARY);
 	init_library();
 }
 
@@ -242,6 +251,7 @@ int get_region_backup_index()
 void reset_wp34s()
 {
 	memfill(&PersistentRam, 0, sizeof(PersistentRam));
+	invalidate_label_index(REGION_RAM);
 	init_34s();
 	display();
 }
@@ -276,6 +286,30 @@ char* get_formatted_register(int anIndex)
 	return buffer;
 }
 
+/*
+ * The raw contents of a register, so that the register view can tell
+ * which registers have changed without formatting them all.
+ */
+const char* get_raw_register(int anIndex, int* aSize)
+{
+	*aSize=is_dblmode() ? sizeof(decimal128) : sizeof(decimal64);
+	return (const char*) get_reg_n(anIndex);
+}
+
+/*
+ * The settings which decide how registers are formatted
+ */
+const char* get_format_settings(int* aSize)
+{
+	*aSize=sizeof(UState);
+	return (const char*) &UState;
+}
+
+int is_running()
+{
+	return Running;
+}
+
 char* get_formatted_displayed_number()
 {
 	static char buffer[FORMATTED_DISPLAYED_NUMBER_LENGTH];
@@ -29,6 +29,7 @@ extern int get_backup_size();
 extern char* get_user_flash();
 extern int get_user_flash_size();
 extern void prepare_memory_save();
+extern void prepare_memory_load();
 extern void after_state_load();
 extern void after_library_load();
 extern void after_backup_load();
@@ -55,6 +56,9 @@ extern int get_first_register_index();
 extern int get_numregs();
 extern int get_maxnumregs();
 extern char* get_formatted_register(int anIndex);
+extern const char* get_raw_register(int anIndex, int* aSize);
+extern const char* get_format_settings(int* aSize);
+extern int is_running();
 extern int is_runmode();
 extern int is_catalogue_mode();
 extern unsigned int current_catalogue(int);
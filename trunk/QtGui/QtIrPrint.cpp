@@ -19,16 +19,41 @@
 
 #define UDPPORT 5025
 
+/*
+ * Bytes are collected and sent a line at a time over a socket that stays open.
+ * The heartbeat sends what is left of an unfinished line.
+ */
+#define IR_BUFFER_SIZE 256
+
+static QUdpSocket* udpSocket;
+static char irBuffer[IR_BUFFER_SIZE];
+static int irLength;
+
 extern "C"
 {
 
+void flush_ir()
+{
+	if(irLength==0)
+	{
+		return;
+	}
+	if(udpSocket==0)
+	{
+		udpSocket=new QUdpSocket();
+	}
+	udpSocket->writeDatagram(irBuffer, irLength, QHostAddress::LocalHost, UDPPORT);
+	irLength=0;
+}
+
 int put_ir( int c )
 {
-	QUdpSocket udpSocket;
-	char ch=(char) c;
 	forward_set_IO_annunciator();
-	udpSocket.writeDatagram(&ch, 1, QHostAddress::LocalHost, UDPPORT);
-	udpSocket.close();
+	irBuffer[irLength++]=(char) c;
+	if(c=='\n' || c==0x04 || irLength==IR_BUFFER_SIZE)
+	{
+		flush_ir();
+	}
 	return 0;
 }
 }
@@ -24,6 +24,7 @@ static const QtKeyCode INVALID_KEY_CODE;
 QtKeyboard::QtKeyboard(const QtSkin& aSkin, bool anUseHShiftClick, bool anAlwaysUseHShiftClick, int anHShiftDelay, bool aShowToolTips)
 	: keyboardBufferBegin(0),
 	  keyboardBufferEnd(0),
+	  pendingInput(0),
 	  currentKeyCode(INVALID_KEY_CODE),
 	  useHShiftClick(anUseHShiftClick),
 	  alwaysUseHShiftClick(anAlwaysUseHShiftClick),
@@ -313,12 +314,17 @@ int QtKeyboard::getKeyNoLock()
 {
 	if(keyboardBufferBegin==keyboardBufferEnd)
 	{
+		pendingInput.fetchAndStoreOrdered(0);
 		return -1;
 	}
 	else
 	{
 		int key=keyboardBuffer[keyboardBufferBegin];
 		keyboardBufferBegin=(keyboardBufferBegin+1)%KEYBOARD_BUFFER_SIZE;
+		if(keyboardBufferBegin==keyboardBufferEnd)
+		{
+			pendingInput.fetchAndStoreOrdered(0);
+		}
 		return key;
 	}
 }
@@ -345,6 +351,7 @@ void QtKeyboard::putKey(char aKey)
 	QMutexLocker mutexLocker(&mutex);
 	keyboardBuffer[keyboardBufferEnd]=aKey;
 	keyboardBufferEnd=(keyboardBufferEnd+1)%KEYBOARD_BUFFER_SIZE;
+	pendingInput.fetchAndStoreOrdered(1);
 	keyWaitCondition.wakeAll();
 }
 
@@ -355,14 +362,20 @@ void QtKeyboard::putKeyIfBufferEmpty(char aKey)
 	{
 		keyboardBuffer[keyboardBufferEnd]=aKey;
 		keyboardBufferEnd=(keyboardBufferEnd+1)%KEYBOARD_BUFFER_SIZE;
+		pendingInput.fetchAndStoreOrdered(1);
 		keyWaitCondition.wakeAll();
 	}
 }
 
+// Called by xeqprog() after every program step, so it doesn't lock.
+// The heartbeat goes through putKeyIfBufferEmpty() and sets the flag too.
 bool QtKeyboard::isKeyPressed()
 {
-	QMutexLocker mutexLocker(&mutex);
-	return isKeyPressedNoLock();
+#if QT_VERSION >= 0x050000
+	return pendingInput.loadAcquire()!=0;
+#else
+	return pendingInput!=0;
+#endif
 }
 
 bool QtKeyboard::isKeyPressedNoLock()
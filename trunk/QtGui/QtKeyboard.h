@@ -19,6 +19,7 @@
 
 #include <QtGui>
 #include <QMutex>
+#include <QAtomicInt>
 #include <QWaitCondition>
 #include "QtSkin.h"
 #include "QtKey.h"
@@ -107,6 +108,9 @@ private:
     QWaitCondition keyWaitCondition;
     char keyboardBuffer[KEYBOARD_BUFFER_SIZE];
     volatile int keyboardBufferBegin, keyboardBufferEnd;
+    // Set while the buffer isn't empty so that isKeyPressed() can be polled
+    // after every program step without taking the mutex
+    QAtomicInt pendingInput;
     QtKeyCode currentKeyCode;
     QtKeyCode lastReleasedKeyCode;
     bool useHShiftClick;
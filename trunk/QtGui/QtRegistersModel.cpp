@@ -34,6 +34,9 @@ QtRegistersModel::QtRegistersModel(QObject* aParent, bool aDisplayAsStack)
 		displayedRegisters.append(QPair<QString, int>(QString("R")+QString("%1").arg(QString::number(i), 2, '0'), i));
 	}
 	lastRowCount=get_numregs();
+	formattedRegisters.resize(displayedRegisters.size());
+	rawRegisters.resize(displayedRegisters.size());
+	lastFormatSettings=formatSettings();
 }
 
 bool QtRegistersModel::isDisplayAsStack()
@@ -46,7 +49,7 @@ void QtRegistersModel::setDisplayAsStack(bool aDisplayAsStack)
 	if(displayAsStack!=aDisplayAsStack)
 	{
 		displayAsStack=aDisplayAsStack;
-		refresh();
+		emit dataChanged(index(0, 0), index(rowCount()-1, columnCount()-1));
 	}
 }
 
@@ -116,7 +119,7 @@ QVariant QtRegistersModel::data(const QModelIndex& anIndex, int aRole) const
     	}
     	else if (anIndex.column() == 1)
     	{
-    		return get_formatted_register(pair.second);
+    		return formattedRegister(index);
     	}
     }
     return QVariant();
@@ -166,17 +169,82 @@ QVariant QtRegistersModel::headerData(int aSection, Qt::Orientation anOrientatio
 	return QVariant();
 }
 
+int QtRegistersModel::rowOf(int anIndex) const
+{
+	if(displayAsStack)
+	{
+		return rowCount()-1-anIndex;
+	}
+	else
+	{
+		return anIndex;
+	}
+}
+
+QString QtRegistersModel::formattedRegister(int anIndex) const
+{
+	if(rawRegisters[anIndex].isEmpty())
+	{
+		int registerIndex=displayedRegisters.at(anIndex).second;
+		rawRegisters[anIndex]=rawRegister(registerIndex);
+		formattedRegisters[anIndex]=get_formatted_register(registerIndex);
+	}
+	return formattedRegisters[anIndex];
+}
+
+QByteArray QtRegistersModel::rawRegister(int anIndex) const
+{
+	int size;
+	const char* data=get_raw_register(anIndex, &size);
+	return QByteArray(data, size);
+}
+
+QByteArray QtRegistersModel::formatSettings() const
+{
+	int size;
+	const char* data=get_format_settings(&size);
+	return QByteArray(data, size);
+}
+
+void QtRegistersModel::clearFormattedRegisters()
+{
+	for(int i=0; i<rawRegisters.size(); i++)
+	{
+		rawRegisters[i].clear();
+	}
+}
+
+/*
+ * Only the registers which have been shown and have changed since are formatted again.
+ * A change in the number of registers or in the display settings refreshes them all.
+ */
 void QtRegistersModel::refresh()
 {
 	int currentRowCount=get_numregs();
+	QByteArray currentFormatSettings=formatSettings();
 	if(lastRowCount!=currentRowCount)
 	{
 		lastRowCount=currentRowCount;
+		clearFormattedRegisters();
 		beginResetModel();
 		endResetModel();
 	}
-	emit dataChanged(index(0, 0), index(rowCount(), columnCount()));
+	else if(lastFormatSettings!=currentFormatSettings)
+	{
+		clearFormattedRegisters();
+		emit dataChanged(index(0, 1), index(rowCount()-1, 1));
+	}
+	else
+	{
+		for(int i=0; i<rowCount(); i++)
+		{
+			if(!rawRegisters[i].isEmpty() && rawRegisters[i]!=rawRegister(displayedRegisters.at(i).second))
+			{
+				rawRegisters[i].clear();
+				int row=rowOf(i);
+				emit dataChanged(index(row, 1), index(row, 1));
+			}
+		}
+	}
+	lastFormatSettings=currentFormatSettings;
 }
-
-
-
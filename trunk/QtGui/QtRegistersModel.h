@@ -20,6 +20,8 @@
 #include <QAbstractTableModel>
 #include <QPair>
 #include <QList>
+#include <QVector>
+#include <QByteArray>
 
 class QtRegistersModel: public QAbstractTableModel
 {
@@ -34,20 +36,32 @@ public:
     QVariant data(const QModelIndex& anIndex, int aRole) const;
     QVariant headerData(int aSection, Qt::Orientation anOrientation, int aRole) const;
     void setPrototypeMode(bool aPrototypeMode);
-    void refresh();
     bool isDisplayAsStack();
     void setDisplayAsStack(bool aDisplayAsStack);
 
+public slots:
+    void refresh();
+
 protected:
     int rowCount() const;
     int columnCount() const;
     QVariant prototypeData(int aColumn) const;
+    int rowOf(int anIndex) const;
+    QString formattedRegister(int anIndex) const;
+    QByteArray rawRegister(int anIndex) const;
+    QByteArray formatSettings() const;
+    void clearFormattedRegisters();
 
 private:
     QList< QPair<QString, int> > displayedRegisters;
     bool prototypeMode;
     bool displayAsStack;
     int lastRowCount;
+    // The registers formatted so far and the raw contents they were formatted from,
+    // an empty raw content means the register has to be formatted again
+    mutable QVector<QString> formattedRegisters;
+    mutable QVector<QByteArray> rawRegisters;
+    QByteArray lastFormatSettings;
 };
 
 #endif /* QTREGISTERSMODEL_H_ */
@@ -17,6 +17,7 @@
 extern "C"
 {
 #include <stdint.h>
+#include <string.h>
 }
 
 #include "QtScreen.h"
@@ -30,8 +31,17 @@ extern "C"
 	uint64_t LcdData[10];
 }
 
-#define SCREEN_ROW_COUNT 10
-#define SCREEN_COLUMN_COUNT 40
+static qreal getDevicePixelRatio(const QPaintDevice& aPaintDevice)
+{
+#if QT_VERSION >= 0x050600
+	return aPaintDevice.devicePixelRatioF();
+#elif QT_VERSION >= 0x050100
+	return aPaintDevice.devicePixelRatio();
+#else
+	Q_UNUSED(aPaintDevice);
+	return 1;
+#endif
+}
 
 #define FONT_FILENAME "DejaVuSans.ttf"
 #define DEFAULT_FONT_FAMILY "Helvetica"
@@ -49,7 +59,9 @@ static int SPECIAL_DIGIT_INDEXES[] = { 1, 2, 3, 4, 5, 6, 7, 8, 24, 25 };
 
 
 QtScreen::QtScreen(const QtSkin& aSkin, bool anUseFonts)
-: useFonts(anUseFonts),
+: dotPixmapRatio(0),
+  repaintAll(true),
+  useFonts(anUseFonts),
   font(NULL),
   fontLower(NULL),
   smallFont(NULL),
@@ -62,6 +74,7 @@ QtScreen::QtScreen(const QtSkin& aSkin, bool anUseFonts)
   menuWidth(0),
   specialDigitPainter(NULL)
 {
+	memset(shownLcdData, 0, sizeof(shownLcdData));
 	setSkin(aSkin);
 	for(int i=0; i<(int) (sizeof(NON_PIXEL_INDEXES)/sizeof(int)); i++)
 	{
@@ -83,6 +96,7 @@ void QtScreen::setUseFonts(bool anUseFonts)
 	if(useFonts!=anUseFonts)
 	{
 		useFonts=anUseFonts;
+		repaintAll=true;
 		updateScreen();
 	}
 }
@@ -95,6 +109,14 @@ void QtScreen::setSkin(const QtSkin& aSkin)
 	dotPainters=aSkin.getDotPainters();
 	pasteRectangle=aSkin.getPasteRectangle();
 	pastePainters=aSkin.getPastePainters();
+	dotRectangles.clear();
+	for(DotPainterListConstIterator dotPainterIterator=dotPainters.begin(); dotPainterIterator!=dotPainters.end(); ++dotPainterIterator)
+	{
+		dotRectangles << (*dotPainterIterator!=NULL ? (*dotPainterIterator)->boundingRect() : QRect());
+	}
+	dotPixmaps.clear();
+	dotPixmapRatio=0;
+	repaintAll=true;
 
 	textOrigin=aSkin.getTextPosition();
 
@@ -211,10 +233,82 @@ int QtScreen::getCatalogMenuWidth() const
 	return menuWidth;
 }
 
+/*
+ * Draw every dot once with the skin's painters, so that a repaint only has to copy
+ * the pixmaps of the lit dots.  It needs the background because some skins copy
+ * their dots from it.  The pixmaps are drawn at the device resolution so the dots
+ * stay sharp on high DPI screens.
+ */
+void QtScreen::buildDotPixmaps(QPixmap& aBackgroundPixmap, qreal aDevicePixelRatio)
+{
+	dotPixmaps.clear();
+	dotPixmapRatio=aDevicePixelRatio;
+	for(int dotIndex=0; dotIndex<dotPainters.size(); dotIndex++)
+	{
+		const QRect& rectangle=dotRectangles[dotIndex];
+		QPixmap dotPixmap(rectangle.size()*aDevicePixelRatio);
+#if QT_VERSION >= 0x050100
+		dotPixmap.setDevicePixelRatio(aDevicePixelRatio);
+#endif
+		if(!rectangle.isEmpty())
+		{
+			dotPixmap.fill(Qt::transparent);
+			QPainter painter(&dotPixmap);
+			painter.setPen(screenForeground);
+			painter.setBrush(QBrush(screenForeground));
+			painter.translate(-rectangle.topLeft());
+			dotPainters[dotIndex]->paint(aBackgroundPixmap, painter);
+		}
+		dotPixmaps << dotPixmap;
+	}
+}
+
+/*
+ * Find the part of the screen to repaint since the last call: the dots which have
+ * changed or the whole screen when text is drawn with fonts and the dot matrix has
+ * changed.
+ */
+QRegion QtScreen::getChangedRegion()
+{
+	QRegion region;
+	bool textChanged=false;
+	for(int row=0; row<SCREEN_ROW_COUNT; row++)
+	{
+		quint64 changed=LcdData[row]^shownLcdData[row];
+		shownLcdData[row]=LcdData[row];
+		for(int column=0; changed!=0; column++, changed>>=1)
+		{
+			if((changed & 1)!=0)
+			{
+				int dotIndex=row*SCREEN_COLUMN_COUNT+column;
+				if(shouldUseFonts() && !nonPixelIndexes.contains(dotIndex))
+				{
+					textChanged=true;
+				}
+				else if(dotIndex<dotRectangles.size())
+				{
+					region+=dotRectangles[dotIndex].translated(screenRectangle.topLeft());
+				}
+			}
+		}
+	}
+	if(repaintAll || textChanged)
+	{
+		repaintAll=false;
+		return QRegion(screenRectangle);
+	}
+	return region;
+}
+
 void QtScreen::paint(QtBackgroundImage& aBackgroundImage, QPaintEvent& aPaintEvent)
 {
-	Q_UNUSED(aPaintEvent);
+	qreal devicePixelRatio=getDevicePixelRatio(aBackgroundImage);
+	if(dotPixmaps.size()!=dotPainters.size() || dotPixmapRatio!=devicePixelRatio)
+	{
+		buildDotPixmaps(aBackgroundImage.getBackgroundPixmap(), devicePixelRatio);
+	}
 
+	QRect area=aPaintEvent.rect().translated(-screenRectangle.topLeft());
 	QPainter painter(&aBackgroundImage);
 	painter.fillRect(screenRectangle, screenBackground);
 	painter.setPen(screenForeground);
@@ -225,12 +319,12 @@ void QtScreen::paint(QtBackgroundImage& aBackgroundImage, QPaintEvent& aPaintEve
 	{
 		for(int column=0; column<SCREEN_COLUMN_COUNT; column++)
 		{
-	      if((LcdData[row] & ((uint64_t) 1) << column)!=0)
+	      if((shownLcdData[row] & ((quint64) 1) << column)!=0)
 	      {
 	    	  int dotIndex=row*SCREEN_COLUMN_COUNT+column;
-	    	  if(!shouldUseFonts() || nonPixelIndexes.contains(dotIndex))
+	    	  if((!shouldUseFonts() || nonPixelIndexes.contains(dotIndex)) && dotRectangles[dotIndex].intersects(area))
 	    	  {
-	    		  dotPainters[dotIndex]->paint(aBackgroundImage.getBackgroundPixmap(), painter);
+	    		  painter.drawPixmap(dotRectangles[dotIndex].topLeft(), dotPixmaps[dotIndex]);
 	    	  }
 	      }
 		}
@@ -22,6 +22,9 @@
 #include "QtSkin.h"
 #include "QtSpecialDigitPainter.h"
 
+#define SCREEN_ROW_COUNT 10
+#define SCREEN_COLUMN_COUNT 40
+
 // We need to forward define it as we are included by QtBackgroundImage.h
 class QtBackgroundImage;
 
@@ -34,6 +37,7 @@ public:
 public:
 	const QRect& getScreenRectangle() const;
 	void paint(QtBackgroundImage& aBackgroundImage, QPaintEvent& aPaintEvent);
+	QRegion getChangedRegion();
 	void copy(QtBackgroundImage& aBackgroundImage, QClipboard& aClipboard) const;
 	void setSkin(const QtSkin& aSkin);
 	bool isUseFonts() const;
@@ -46,6 +50,7 @@ public:
 private:
 	bool shouldUseFonts() const;
 	char convertCharInDisplayedNumber(char c) const;
+	void buildDotPixmaps(QPixmap& aBackgroundPixmap, qreal aDevicePixelRatio);
 
 private:
 	QRect screenRectangle;
@@ -54,6 +59,14 @@ private:
     QColor screenBackground;
     DotPainterList dotPainters;
     DotPainterList pastePainters;
+    // Where each dot is drawn and what it looks like, drawn once per skin
+    // and device pixel ratio
+    QVector<QRect> dotRectangles;
+    QVector<QPixmap> dotPixmaps;
+    qreal dotPixmapRatio;
+    // The LCD contents the last update was asked for
+    quint64 shownLcdData[SCREEN_ROW_COUNT];
+    bool repaintAll;
     bool useFonts;
     QSet<int> nonPixelIndexes;
     QSet<int> specialDigitIndexes;
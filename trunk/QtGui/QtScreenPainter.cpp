@@ -37,6 +37,12 @@ void PolygonPainter::paint(QPixmap& aPixmap, QPainter& aPainter)
 	aPainter.drawPolygon(polygon);
 }
 
+QRect PolygonPainter::boundingRect() const
+{
+	// The outline is drawn one pixel right and below the polygon's corners
+	return polygon.boundingRect().adjusted(0, 0, 1, 1);
+}
+
 
 CopyPainter::CopyPainter(const QRect& aSource, const QPoint& aDestination)
 	: source(aSource), destination(aDestination)
@@ -49,6 +55,11 @@ void CopyPainter::paint(QPixmap& aPixmap, QPainter& aPainter)
 	aPainter.drawPixmap(destination, copy);
 }
 
+QRect CopyPainter::boundingRect() const
+{
+	return QRect(destination, source.size());
+}
+
 DotPainter::DotPainter()
 {
 }
@@ -61,6 +72,16 @@ void DotPainter::paint(QPixmap& aPixmap, QPainter& aPainter)
 	}
 }
 
+QRect DotPainter::boundingRect() const
+{
+	QRect rectangle;
+	for(LCDPainterList::const_iterator painterIterator=lcdPainters.begin(); painterIterator!=lcdPainters.end(); ++painterIterator)
+	{
+		rectangle|=(*painterIterator)->boundingRect();
+	}
+	return rectangle;
+}
+
 void DotPainter::addLCDPainter(QtScreenPainter* aLCDPainter)
 {
 	if(aLCDPainter!=NULL)
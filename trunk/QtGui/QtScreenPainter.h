@@ -26,6 +26,7 @@ public:
 	QtScreenPainter();
 	virtual ~QtScreenPainter();
 	virtual void paint(QPixmap& aPixmap, QPainter& aPainter)=0;
+	virtual QRect boundingRect() const=0;
 };
 
 class PolygonPainter: public QtScreenPainter
@@ -33,6 +34,7 @@ class PolygonPainter: public QtScreenPainter
 public:
 	PolygonPainter(const QPolygon& aPolygon);
 	void paint(QPixmap& aPixmap, QPainter& aPainter);
+	QRect boundingRect() const;
 
 private:
 	QPolygon polygon;
@@ -43,6 +45,7 @@ class CopyPainter: public QtScreenPainter
 public:
 	CopyPainter(const QRect& aSource, const QPoint& aDestination);
 	void paint(QPixmap& aPixmap, QPainter& aPainter);
+	QRect boundingRect() const;
 
 private:
 	QRect source;
@@ -57,6 +60,7 @@ class DotPainter: public QtScreenPainter
 public:
 	DotPainter();
 	void paint(QPixmap& aPixmap, QPainter& aPainter);
+	QRect boundingRect() const;
 	void addLCDPainter(QtScreenPainter* aLCDPainter);
 
 private:
@@ -28,12 +28,18 @@ void PrintDataReader::run()
 	for(;;)
 	{
 		udpSocket->waitForReadyRead();
+		// Hand everything that has arrived to the paper in one go
+		QByteArray data;
 		while (udpSocket->hasPendingDatagrams())
 		{
 			QByteArray datagram;
 			datagram.resize(udpSocket->pendingDatagramSize());
 			udpSocket->readDatagram(datagram.data(), datagram.size());
-			printerEmulator.append(datagram);
+			data.append(datagram);
+		}
+		if(!data.isEmpty())
+		{
+			printerEmulator.append(data);
 		}
 	}
 }
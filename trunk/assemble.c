@@ -0,0 +1,756 @@
+/* This file is part of 34S.
+ *
+ * 34S is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * 34S is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with 34S.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ *  Program assembler for the emulators.
+ *
+ *  Reads the source format of tools/wp34s_asm.pl (step numbers, // and
+ *  C style comments, [name] escapes, aliases, quoted alpha labels) and
+ *  produces program words in memory.  The mnemonic table is built on
+ *  first use from prt(), the same function that shows program steps on
+ *  the calculator and writes them in export_textfile(), so everything
+ *  exported can be read back.  The aliases are the ones dump_opcodes()
+ *  writes to the opcode table of the perl assembler.
+ *
+ *  The preprocessor syntax (symbolic labels, JMP etc.) isn't handled here,
+ *  import_textfile() passes such files on to the external assembler.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "xeq.h"
+#include "consts.h"
+#include "display.h"
+#include "storage.h"
+
+#if !defined(REALBUILD) && !defined(IOS)
+
+#include "pretty.h"
+
+#define ASM_TABLE_SIZE	0x20000		// Power of two, well above the number of mnemonics
+#define ASM_LINE_MAX	500
+#define ASM_NARROW_SPACE 6		// Separates a command from its argument in prt()
+#define ASM_POINTER	13		// [->], marks an indirect argument
+
+static INSTANCE struct _asm_entry {
+	char *name;
+	opcode op;
+} *AsmTable;
+
+/*
+ *  Character names as in [name] escapes
+ */
+static const char *asm_pretty(unsigned char c) {
+	if (c < 32)
+		return map32[c];
+	if (c >= 127)
+		return maptop[c - 127];
+	return CNULL;
+}
+
+/*
+ *  Hash table of all mnemonics and their aliases.
+ *  The first definition of a name wins, as it does in the perl assembler.
+ */
+static unsigned int asm_hash(const char *s) {
+	unsigned int h = 2166136261u;
+
+	while (*s != '\0')
+		h = (h ^ (unsigned char) *s++) * 16777619u;
+	return h & (ASM_TABLE_SIZE - 1);
+}
+
+static struct _asm_entry *asm_slot(const char *name) {
+	unsigned int h = asm_hash(name);
+
+	while (AsmTable[h].name != NULL && strcmp(AsmTable[h].name, name) != 0)
+		h = (h + 1) & (ASM_TABLE_SIZE - 1);
+	return AsmTable + h;
+}
+
+static void asm_add(const char *name, opcode op) {
+	struct _asm_entry *const e = asm_slot(name);
+
+	if (e->name == NULL && *name != '\0') {
+		e->name = (char *) malloc(strlen(name) + 1);
+		if (e->name != NULL) {
+			strcpy(e->name, name);
+			e->op = op;
+		}
+	}
+}
+
+static int asm_find(const char *name, opcode *op) {
+	const struct _asm_entry *const e = asm_slot(name);
+
+	if (e->name == NULL)
+		return 0;
+	*op = e->op;
+	return 1;
+}
+
+/*
+ *  Copy a fixed length name from the command tables
+ */
+static char *asm_name(char *out, const char *name, int n) {
+	while (n-- > 0 && *name != '\0')
+		*out++ = *name++;
+	*out = '\0';
+	return out;
+}
+
+/*
+ *  Character names without the brackets, the alias form of a mnemonic.
+ *  With subst set, approx and cmplx are shortened as in prettify().
+ */
+static void asm_plain(const char *in, char *out, int subst) {
+	while (*in != '\0') {
+		const char *p = asm_pretty(*in);
+
+		if (p == CNULL) {
+			*out++ = *in++;
+			continue;
+		}
+		++in;
+		if (subst && strcmp(p, "approx") == 0)
+			p = "~";
+		else if (subst && strcmp(p, "cmplx") == 0)
+			p = "c";
+		while (*p != '\0')
+			*out++ = *p++;
+	}
+	*out = '\0';
+}
+
+static int asm_has_escapes(const char *s) {
+	while (*s != '\0')
+		if (asm_pretty(*s++) != CNULL)
+			return 1;
+	return 0;
+}
+
+/*
+ *  The mnemonic of a single word opcode as shown by prt() with the
+ *  narrow spaces before the argument turned into a single blank.
+ */
+static void asm_key(opcode op, char *out) {
+	char buf[16];
+	const char *p = prt(op, buf);
+
+	while (*p != '\0') {
+		if (*p == ASM_NARROW_SPACE) {
+			*out++ = ' ';
+			while (*p == ASM_NARROW_SPACE)
+				++p;
+			if (isRARG(op) && RARG_CMD(op) == RARG_ALPHA) {
+				// The argument is the character itself
+				*out++ = op & 0xff;
+				break;
+			}
+			continue;
+		}
+		*out++ = *p++;
+	}
+	*out = '\0';
+}
+
+static void asm_add_multi(opcode op) {
+	const unsigned int cmd = opDBL(op);
+	char name[ASM_LINE_MAX];
+	char *p = asm_name(name, multicmds[cmd].cmd, NAME_LEN);
+
+	*p++ = '\'';
+	*p = '\0';
+	asm_add(name, op);
+	if (multicmds[cmd].alias != NULL) {
+		sprintf(name, "%s'", multicmds[cmd].alias);
+		asm_add(name, op);
+	}
+}
+
+static void asm_add_rarg(opcode op) {
+	const unsigned int cmd = RARG_CMD(op);
+	const unsigned int arg = op & 0xff;
+	char key[ASM_LINE_MAX], alias[ASM_LINE_MAX];
+	char *p;
+
+	if (cmd >= NUM_RARG)
+		return;
+	if (cmd == RARG_MODE_SET || cmd == RARG_MODE_CLEAR
+			|| cmd == RARG_XROM_IN || cmd == RARG_XROM_OUT
+#ifdef XROM_RARG_COMMANDS
+			|| cmd == RARG_XROM_ARG
+#endif
+	   )
+		return;
+
+	if (cmd == RARG_ALPHA) {
+		if (arg == 0)
+			return;
+	}
+	else if (cmd == RARG_CONST || cmd == RARG_CONST_CMPLX) {
+		if ((arg & RARG_IND) != 0 || arg == OP_ZERO || arg == OP_ONE)
+			return;
+	}
+	else if (cmd == RARG_CONV) {
+		if ((arg & RARG_IND) != 0)
+			return;
+	}
+	else if (cmd != RARG_SHUFFLE) {
+		/* Commands without indirection use the whole byte */
+		if (argcmds[cmd].indirectokay && (arg & RARG_IND) != 0)
+			;
+		else {
+			unsigned int limit = argcmds[cmd].lim + 1;
+
+			if (argcmds[cmd].indirectokay && limit > RARG_IND)
+				limit = RARG_IND;
+			if (arg >= limit)
+				return;
+			if ((cmd == RARG_STOSTK || cmd == RARG_RCLSTK) && arg > 96 && arg < 112)
+				return;
+		}
+	}
+
+	asm_key(op, key);
+	if (strcmp(key, "???") == 0)
+		return;
+	asm_add(key, op);
+
+	/* Aliases */
+	if (cmd == RARG_ALPHA) {
+		const char c = (char) arg;
+		const char *name = asm_pretty(c);
+
+		if (name == CNULL || strlen(name) == 1)
+			sprintf(alias, "'%c'", c);
+		else
+			sprintf(alias, "'%s'", name);
+		asm_add(alias, op);
+	}
+	else if (cmd == RARG_CONST || cmd == RARG_CONST_CMPLX) {
+		const char *pre = arg == OP_PI ? "" : "# ";
+		const char *name = cnsts[arg].alias;
+
+		p = strchr(key, ' ');
+		if (! asm_has_escapes(p + 1))
+			name = NULL;
+		if (cmd == RARG_CONST_CMPLX)
+			sprintf(alias, "c%s%s", pre, name != NULL ? name : p + 1);
+		else if (name != NULL)
+			sprintf(alias, "%s%s", pre, name);
+		else
+			return;
+		asm_add(alias, op);
+	}
+	else if (cmd == RARG_CONV) {
+		p = strchr(key, ASM_POINTER);
+		if (p != NULL) {
+			*p = '>';
+			asm_add(key, op);
+		}
+	}
+	else if (cmd == RARG_SHUFFLE) {
+		sprintf(alias, "<>%s", strchr(key, ' '));
+		asm_add(alias, op);
+	}
+	else {
+		if (op == RARG(RARG_SWAPX, regY_idx)) {
+			asm_add("x<>y", op);
+			asm_add("SWAP", op);
+		}
+		else if (op == RARG(RARG_CSWAPX, regZ_idx))
+			asm_add("cSWAP", op);
+
+		/* Three digit arguments the display shows with two */
+		if (arg >= 100 && (p = strchr(key, ' ')) != NULL) {
+			sprintf(p, " %u", arg);
+			asm_add(key, op);
+		}
+	}
+}
+
+static void asm_add_op(opcode op) {
+	const unsigned int kind = opKIND(op);
+	const unsigned int d = argKIND(op);
+	char key[ASM_LINE_MAX], alias[ASM_LINE_MAX];
+	const char *p = NULL;
+
+	switch (kind) {
+	case KIND_SPEC:
+		break;
+
+	case KIND_NIL:
+		if (d >= NUM_NILADIC || (d >= OP_CLALL && d <= OP_CLPALL))
+			return;
+		if (d == OP_LOADA2D || d == OP_SAVEA2D || d == OP_GSBuser || d == OP_POPUSR)
+			return;
+#ifdef INCLUDE_STOPWATCH
+		if (d == OP_STOPWATCH)
+			return;
+#endif
+		p = niladics[d].alias;
+		break;
+
+	case KIND_MON:
+		if (d >= NUM_MONADIC || (isNULL(monfuncs[d].mondreal) && isNULL(monfuncs[d].monint)))
+			return;
+		p = monfuncs[d].alias;
+		break;
+
+	case KIND_DYA:
+		if (d >= NUM_DYADIC || (isNULL(dyfuncs[d].dydreal) && isNULL(dyfuncs[d].dydint)))
+			return;
+		p = dyfuncs[d].alias;
+		break;
+
+	case KIND_TRI:
+		if (d >= NUM_TRIADIC)
+			return;
+		p = trifuncs[d].alias;
+		break;
+
+	case KIND_CMON:
+		if (d >= NUM_MONADIC || isNULL(monfuncs[d].mondcmplx))
+			return;
+		p = monfuncs[d].alias;
+		break;
+
+	case KIND_CDYA:
+		if (d >= NUM_DYADIC || isNULL(dyfuncs[d].dydcmplx))
+			return;
+		p = dyfuncs[d].alias;
+		break;
+
+	default:
+		return;
+	}
+
+	asm_key(op, key);
+	if (strcmp(key, "???") == 0)
+		return;
+	asm_add(key, op);
+
+	/* Aliases */
+	if (kind == KIND_SPEC) {
+		if (d == OP_ENTER)
+			p = "ENTER";
+		else if (d == OP_CHS)
+			p = "CHS";
+		else if (asm_has_escapes(key)) {
+			asm_plain(key, alias, 1);
+			p = alias;
+		}
+	}
+	else if (kind == KIND_CMON || kind == KIND_CDYA) {
+		char name[16];
+
+		catcmd(op, name);
+		if (name[0] == COMPLEX_PREFIX)
+			asm_plain(name, alias, 1);
+		else
+			sprintf(alias, "c%s", p != NULL ? p : name);
+		p = alias;
+		if (op == (OP_CMON | OP_CCHS))
+			asm_add("cCHS", op);
+	}
+	if (p != NULL)
+		asm_add(p, op);
+}
+
+static int asm_init(void) {
+	unsigned int op;
+
+	if (AsmTable != NULL)
+		return 1;
+	AsmTable = (struct _asm_entry *) calloc(ASM_TABLE_SIZE, sizeof(struct _asm_entry));
+	if (AsmTable == NULL)
+		return 0;
+
+	for (op = 0; op < 0x10000; ++op) {
+		if (isDBL(op)) {
+			if ((op & 0xff) == 0 && opDBL(op) < NUM_MULTI
+#ifdef XROM_LONG_BRANCH
+					&& opDBL(op) != DBL_XBR
+#endif
+			   )
+				asm_add_multi(op);
+		}
+		else if (isRARG(op))
+			asm_add_rarg(op);
+		else
+			asm_add_op(op);
+	}
+	return 1;
+}
+
+/*
+ *  Turn [name] escapes into the calculator's character codes
+ */
+static int asm_escape(const char *name, int len) {
+	int c;
+
+	if (len == 5 && strncmp(name, "space", 5) == 0)
+		return ' ';
+	for (c = 1; c < 256; ++c) {
+		const char *p = asm_pretty(c);
+
+		if (p != CNULL && (int) strlen(p) == len && strncmp(p, name, len) == 0)
+			return c;
+	}
+	return -1;
+}
+
+static void asm_unescape(const char *in, char *out) {
+	while (*in != '\0') {
+		if (*in == '[') {
+			const char *e = strchr(in + 1, ']');
+
+			if (e != NULL) {
+				const int c = asm_escape(in + 1, (int) (e - in - 1));
+
+				if (c > 0) {
+					*out++ = c;
+					in = e + 1;
+					continue;
+				}
+			}
+		}
+		*out++ = *in++;
+	}
+	*out = '\0';
+}
+
+/*
+ *  Accept "CMD ->nn", "CMD =>nn", "CMD >nn" and "CMD @nn" for CMD[->]nn
+ */
+static void asm_indirect(char *s) {
+	static const char *const pointers[] = { "->", "=>", ">", "@" };
+	char *p = strrchr(s, ' ');
+	unsigned int i;
+
+	if (p == NULL)
+		return;
+	for (i = 0; i < sizeof(pointers) / sizeof(pointers[0]); ++i) {
+		const int n = (int) strlen(pointers[i]);
+
+		if (strncmp(p + 1, pointers[i], n) == 0 && p[n + 1] != '\0') {
+			*p = ASM_POINTER;
+			memmove(p + 1, p + n + 1, strlen(p + n + 1) + 1);
+			return;
+		}
+	}
+}
+
+/*
+ *  Pad the first numeric argument with a zero: "STO 5" -> "STO 05"
+ */
+static int asm_zero_extend(char *s) {
+	char *p;
+
+	for (p = s; *p != '\0'; ++p)
+		if (*p == ' ' && p[1] >= '0' && p[1] <= '9') {
+			memmove(p + 2, p + 1, strlen(p + 1) + 1);
+			p[1] = '0';
+			return 1;
+		}
+	return 0;
+}
+
+/*
+ *  Replace an alias of an argument command: "STO* 12" -> "STO[times] 12"
+ */
+static int asm_arg_alias(const char *s, char *out) {
+	const char *p = s;
+	unsigned int cmd;
+	int n;
+
+	while (*p != '\0' && *p != ' ' && *p != ASM_POINTER)
+		++p;
+	if (*p == '\0')
+		return 0;
+	n = (int) (p - s);
+	for (cmd = 0; cmd < NUM_RARG; ++cmd) {
+		const char *alias = argcmds[cmd].alias;
+
+		if (alias != NULL && (int) strlen(alias) == n && strncmp(alias, s, n) == 0) {
+			strcpy(asm_name(out, argcmds[cmd].cmd, NAME_LEN), p);
+			return 1;
+		}
+	}
+	return 0;
+}
+
+/*
+ *  Drop a leading zero of the last argument: "gDIM 005" -> "gDIM 05"
+ */
+static int asm_zero_strip(char *s) {
+	char *p = strrchr(s, ' ');
+
+	if (p == NULL || p[1] != '0' || p[2] < '0' || p[2] > '9')
+		return 0;
+	memmove(p + 1, p + 2, strlen(p + 2) + 1);
+	return 1;
+}
+
+static int asm_try(const char *s, opcode *op) {
+	char buf[ASM_LINE_MAX + 8];
+
+	return asm_find(s, op) || (asm_arg_alias(s, buf) && asm_find(buf, op));
+}
+
+/*
+ *  Look a mnemonic up, allowing for fewer or more argument digits
+ */
+static int asm_lookup(char *s, opcode *op) {
+	char orig[ASM_LINE_MAX + 8];
+	int tries;
+
+	strcpy(orig, s);
+	for (tries = 0; tries < 3; ++tries) {
+		if (asm_try(s, op))
+			return 1;
+		if (strlen(s) + 1 >= ASM_LINE_MAX || ! asm_zero_extend(s))
+			break;
+	}
+	strcpy(s, orig);
+	while (asm_zero_strip(s))
+		if (asm_try(s, op))
+			return 1;
+	return 0;
+}
+
+/*
+ *  Assemble a single step: the mnemonic without step number or comment.
+ *  Returns the number of words stored or zero if there is no such step.
+ */
+int assemble_step(const char *line, s_opcode *words, char *message) {
+	char buf[ASM_LINE_MAX + 8], text[ASM_LINE_MAX + 8];
+	char *p, *q;
+	opcode op;
+	int n;
+
+	if (! asm_init()) {
+		strcpy(message, "Out of memory");
+		return 0;
+	}
+	if (strlen(line) >= ASM_LINE_MAX) {
+		strcpy(message, "Line too long");
+		return 0;
+	}
+
+	/* Single blanks only, no leading or trailing white space */
+	for (p = buf; *line != '\0'; ++line) {
+		if (*line == ' ' || *line == '\t') {
+			if (p != buf && p[-1] != ' ')
+				*p++ = ' ';
+		}
+		else
+			*p++ = *line;
+	}
+	if (p != buf && p[-1] == ' ')
+		--p;
+	*p = '\0';
+
+	/* Labels are sometimes marked with an asterisk */
+	for (p = buf; *p == '*'; ++p)
+		;
+	if (p != buf && strncmp(p, "LBL", 3) == 0)
+		memmove(buf, p, strlen(p) + 1);
+
+	/* Quoted text of an alpha label or XEQ'ABC', the command is XEQ' */
+	*text = '\0';
+	q = strrchr(buf, '\'');
+	if (q != NULL && q != buf) {
+		for (p = q - 1; p != buf && *p != '\''; --p)
+			;
+		if (*p == '\'' && p != buf && p[-1] != ' ' && p + 1 != q) {
+			*q = '\0';
+			if (strchr(p + 1, ' ') == NULL) {
+				asm_unescape(p + 1, text);
+				p[1] = '\0';
+			}
+			else
+				*q = '\'';
+		}
+	}
+
+	asm_unescape(buf, buf);
+	asm_indirect(buf);
+	if (! asm_lookup(buf, &op)) {
+		strcpy(message, "Cannot recognize mnemonic");
+		return 0;
+	}
+
+	if (! isDBL(op)) {
+		if (*text != '\0') {
+			strcpy(message, "Unexpected label text");
+			return 0;
+		}
+		words[0] = (s_opcode) op;
+		return 1;
+	}
+	n = (int) strlen(text);
+	if (n == 0 || n > 3) {
+		strcpy(message, "Label text must be one to three characters");
+		return 0;
+	}
+	if (n == 3 && (unsigned char) text[2] >= 0xf0) {
+		// The calculator can't handle these in the last position
+		strcpy(message, "Character not allowed in the third position");
+		return 0;
+	}
+	words[0] = (s_opcode) (op | (unsigned char) text[0]);
+	words[1] = n == 1 ? 0 : (s_opcode) ((unsigned char) text[1] | (n == 3 ? (unsigned char) text[2] << 8 : 0));
+	return 2;
+}
+
+static int asm_label_char(char c) {
+	return (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || (c >= '0' && c <= '9') || c == '_';
+}
+
+/*
+ *  Does a line that didn't assemble use the syntax of the preprocessor:
+ *  a Name:: target, a "string", an XLBL or a branch to a symbolic label?
+ */
+static int asm_preprocessor(const char *line) {
+	static const char *const branches[] = {
+		"JMP", "GSB", "BACK", "SKIP", "BSRB", "BSRF", "GTO", "XEQ",
+		"SLV", "INT", "[integral]", "[PI]", "[SIGMA]", "f'(x)", "f\"(x)", NULL
+	};
+	const char *p, *q;
+	int i, n, alpha;
+
+	for (p = line; (p = strstr(p, "::")) != NULL; p += 2)
+		if (p != line && asm_label_char(p[-1]))
+			return 1;
+	if (strncmp(line, "XLBL\"", 5) == 0)
+		return 1;
+	p = strchr(line, '"');
+	if (p != NULL && strchr(p + 1, '"') != NULL)
+		return 1;
+
+	/* A symbolic label has two or more characters, not all of them digits */
+	for (q = line + strlen(line); q != line && (q[-1] == ' ' || q[-1] == '\t'); --q)
+		;
+	for (n = alpha = 0; q != line && asm_label_char(q[-1]); --q, ++n)
+		alpha |= q[-1] < '0' || q[-1] > '9';
+	if (n < 2 || ! alpha || q == line || (q[-1] != ' ' && q[-1] != '\t'))
+		return 0;
+	for (i = 0; branches[i] != NULL; ++i) {
+		n = (int) strlen(branches[i]);
+		if (strncmp(line, branches[i], n) == 0 && (line[n] == ' ' || line[n] == '\t'))
+			return 1;
+	}
+	return 0;
+}
+
+/*
+ *  Assemble a source file into words.  Returns the number of words or -1
+ *  on error with the reason and the line number in message.  Files that
+ *  need the preprocessor return ASM_PREPROCESSOR instead.
+ */
+int assemble_file(const char *filename, s_opcode *prog, int max, char *message, int length) {
+	char line[ASM_LINE_MAX + 8], msg[100];
+	int words = 0, steps = 0, lineno = 0, in_comment = 0;
+	opcode last = 0;
+	FILE *f = fopen(filename, "rt");
+
+	if (f == NULL) {
+		snprintf(message, length, "Cannot open %s", filename);
+		return -1;
+	}
+	while (fgets(line, sizeof(line), f) != NULL) {
+		char *p = line, *q;
+		int n;
+
+		++lineno;
+		if (lineno == 1 && strncmp(p, "\357\273\277", 3) == 0)
+			p += 3;		// UTF-8 byte order mark
+
+		/* Comments */
+		if (in_comment) {
+			q = strstr(p, "*/");
+			if (q == NULL)
+				continue;
+			p = q + 2;
+			in_comment = 0;
+		}
+		if ((q = strstr(p, "//")) != NULL)
+			*q = '\0';
+		while ((q = strstr(p, "/*")) != NULL) {
+			char *e = strstr(q + 2, "*/");
+
+			if (e == NULL) {
+				*q = '\0';
+				in_comment = 1;
+				break;
+			}
+			memmove(q, e + 2, strlen(e + 2) + 1);
+		}
+		for (q = p; *q != '\0'; ++q)
+			if (*q == '\r' || *q == '\n')
+				*q = '\0';
+
+		/* Step numbers */
+		while (*p == ' ' || *p == '\t')
+			++p;
+		for (n = 0; p[n] >= '0' && p[n] <= '9'; ++n)
+			;
+		if (n >= 3 && n <= 4 && (p[n] == ':' || p[n] == ' ' || p[n] == '\t' || p[n] == '\0'))
+			p += n + (p[n] == ':');
+		while (*p == ' ' || *p == '\t')
+			++p;
+		if (*p == '\0')
+			continue;
+
+		if (words + 2 > max) {
+			snprintf(message, length, "Line %d: Too many program steps", lineno);
+			fclose(f);
+			return -1;
+		}
+		n = assemble_step(p, prog + words, msg);
+		if (n == 0) {
+			if (asm_preprocessor(p)) {
+				snprintf(message, length, "Line %d: Needs the preprocessor: %s", lineno, p);
+				fclose(f);
+				return ASM_PREPROCESSOR;
+			}
+			snprintf(message, length, "Line %d: %s: %s", lineno, msg, p);
+			fclose(f);
+			return -1;
+		}
+		last = prog[words];
+		words += n;
+		++steps;
+	}
+	fclose(f);
+
+	/* A program ends with END */
+	if (steps == 0 || last != (OP_NIL | OP_END)) {
+		if (words + 1 > max) {
+			snprintf(message, length, "Too many program steps");
+			return -1;
+		}
+		prog[words++] = OP_NIL | OP_END;
+		++steps;
+	}
+	snprintf(message, length, "Total words: %d\nTotal steps: %d", words, steps);
+	return words;
+}
+
+#endif
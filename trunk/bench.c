@@ -0,0 +1,307 @@
+/* This file is part of 34S.
+ *
+ * 34S is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * 34S is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with 34S.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ *  Micro benchmarks for the console emulator: "calc bench [name...]"
+ *
+ *  Times the core decNumber functions and a selection of XROM routines
+ *  in single and double precision.  Every case is calibrated to run for
+ *  at least BENCH_TRIAL_NS, the best of BENCH_TRIALS trials is reported.
+ *  XROM cases also report the number of instructions executed per call,
+ *  which doesn't depend on the host and is exact across commits.
+ */
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "xeq.h"
+#include "decn.h"
+#include "stats.h"
+#include "storage.h"
+#include "matrix.h"
+
+#define BENCH_TRIALS	5
+#define BENCH_TRIAL_NS	20000000ULL
+
+/*
+ *  Arguments, converted once before a case is timed
+ */
+static decNumber BenchX, BenchY, BenchZ;
+
+static void bench_args(const char *x, const char *y, const char *z)
+{
+	decNumberFromString(&BenchX, x, &Ctx);
+	decNumberFromString(&BenchY, y != NULL ? y : "0", &Ctx);
+	decNumberFromString(&BenchZ, z != NULL ? z : "0", &Ctx);
+}
+
+/*
+ *  The decNumber functions
+ */
+static void bench_ln(void)
+{
+	decNumber r;
+	dn_ln(&r, &BenchX);
+}
+
+static void bench_exp(void)
+{
+	decNumber r;
+	dn_exp(&r, &BenchX);
+}
+
+static void bench_sincos(void)
+{
+	decNumber s, c;
+	dn_sincos(&BenchX, &s, &c);
+}
+
+static void bench_atan(void)
+{
+	decNumber r;
+	do_atan(&r, &BenchX);
+}
+
+static void bench_gamma(void)
+{
+	decNumber r;
+	decNumberGamma(&r, &BenchX);
+}
+
+static void bench_lngamma(void)
+{
+	decNumber r;
+	decNumberLnGamma(&r, &BenchX);
+}
+
+static void bench_gammap(void)
+{
+	decNumber r;
+	decNumberGammap(&r, &BenchY, &BenchX);
+}
+
+static void bench_betai(void)
+{
+	decNumber r;
+	betai(&r, &BenchZ, &BenchY, &BenchX);
+}
+
+/*
+ *  The matrix kernels on a full size 10 by 10 operand
+ */
+static decimal64 BenchA[100], BenchB[100], BenchC[100];
+
+static void bench_matrix_init(void)
+{
+	decNumber t, u;
+	int i;
+
+	for (i = 0; i < 100; i++) {
+		int_to_dn(&t, (i * 37) % 101 - 50);
+		int_to_dn(&u, 7);
+		dn_divide(&t, &t, &u);
+		packed_from_number(BenchA + i, &t);
+		int_to_dn(&t, (i * 53) % 97 - 48);
+		int_to_dn(&u, 3);
+		dn_divide(&t, &t, &u);
+		packed_from_number(BenchB + i, &t);
+	}
+}
+
+static void bench_gemm(void)
+{
+	matrix_gemm(BenchC, BenchA, BenchB, 10, 10, 10, 0);
+}
+
+static void bench_gemm_t(void)
+{
+	matrix_gemm(BenchC, BenchA, BenchB, 10, 10, 10, 1);
+}
+
+static void bench_axpy(void)
+{
+	xcopy(BenchC, BenchA, sizeof(BenchC));
+	matrix_axpy(BenchC, BenchB, &BenchX, 100);
+}
+
+/*
+ *  XROM routines are started like a key press and run to completion
+ */
+static opcode BenchOp;
+
+static void bench_xeq(void)
+{
+	setRegister(regZ_idx, &BenchZ);
+	setRegister(regY_idx, &BenchY);
+	setRegister(regX_idx, &BenchX);
+	xeq(BenchOp);
+	while (Running || Pause) {
+		Pause = 0;
+		xeqprog();
+	}
+}
+
+/*
+ *  User code for the integrator and the solver:
+ *  LBL 00: x^2, LBL 01: x^2 - R00
+ */
+static void bench_program(void)
+{
+	static const opcode prog[] = {
+		RARG(RARG_LBL, 0), OP_MON | OP_SQR, OP_NIL | OP_RTN,
+		RARG(RARG_LBL, 1), OP_MON | OP_SQR, RARG(RARG_RCL_MI, 0), OP_NIL | OP_RTN,
+	};
+	decNumber two;
+	unsigned int i;
+
+	clpall();
+	State2.runmode = 0;
+	set_pc(0);
+	for (i = 0; i < sizeof(prog) / sizeof(prog[0]); i++)
+		stoprog(prog[i]);
+	State2.runmode = 1;
+	set_pc(1);
+	update_program_bounds(1);
+	int_to_dn(&two, 2);
+	setRegister(0, &two);
+}
+
+static const struct {
+	const char *name;
+	void (*f)(void);
+	opcode op;
+	const char *x, *y, *z;		/* X, Y, Z or the function arguments */
+	const char *j, *k;		/* distribution parameters */
+} bench_cases[] = {
+	{ "dn_ln",		&bench_ln,	0,	"2.5", NULL, NULL, NULL, NULL },
+	{ "dn_exp",		&bench_exp,	0,	"1.7", NULL, NULL, NULL, NULL },
+	{ "dn_sincos",		&bench_sincos,	0,	"0.7", NULL, NULL, NULL, NULL },
+	{ "do_atan",		&bench_atan,	0,	"0.3", NULL, NULL, NULL, NULL },
+	{ "decNumberGamma",	&bench_gamma,	0,	"4.3", NULL, NULL, NULL, NULL },
+	{ "decNumberLnGamma",	&bench_lngamma,	0,	"12.5", NULL, NULL, NULL, NULL },
+	{ "decNumberGammap",	&bench_gammap,	0,	"1.5", "2.5", NULL, NULL, NULL },
+	{ "betai",		&bench_betai,	0,	"0.4", "2.5", "3.5", NULL, NULL },
+	{ "matrix_gemm",	&bench_gemm,	0,	"0", NULL, NULL, NULL, NULL },
+	{ "matrix_gemm_t",	&bench_gemm_t,	0,	"0", NULL, NULL, NULL, NULL },
+	{ "matrix_axpy",	&bench_axpy,	0,	"-1.5", NULL, NULL, NULL, NULL },
+	{ "integrate",		&bench_xeq,	RARG(RARG_INTG, 0),	"1", "0", NULL, NULL, NULL },
+	{ "solve",		&bench_xeq,	RARG(RARG_SOLVE, 1),	"2", "1", NULL, NULL, NULL },
+	{ "cdf_Q",		&bench_xeq,	OP_MON | OP_cdf_Q,	"1.3", NULL, NULL, NULL, NULL },
+	{ "qf_Q",		&bench_xeq,	OP_MON | OP_qf_Q,	"0.9", NULL, NULL, NULL, NULL },
+	{ "cdf_T",		&bench_xeq,	OP_MON | OP_cdf_T,	"1.3", NULL, NULL, "5", NULL },
+	{ "qf_T",		&bench_xeq,	OP_MON | OP_qf_T,	"0.9", NULL, NULL, "5", NULL },
+	{ "cdf_chi2",		&bench_xeq,	OP_MON | OP_cdf_chi2,	"2.5", NULL, NULL, "3", NULL },
+	{ "qf_chi2",		&bench_xeq,	OP_MON | OP_qf_chi2,	"0.9", NULL, NULL, "3", NULL },
+	{ "cdf_F",		&bench_xeq,	OP_MON | OP_cdf_F,	"1.5", NULL, NULL, "4", "7" },
+	{ "qf_F",		&bench_xeq,	OP_MON | OP_qf_F,	"0.9", NULL, NULL, "4", "7" },
+	{ "cdf_Plam",		&bench_xeq,	OP_MON | OP_cdf_Plam,	"3", NULL, NULL, "2.5", NULL },
+	{ "qf_Plam",		&bench_xeq,	OP_MON | OP_qf_Plam,	"0.9", NULL, NULL, "2.5", NULL },
+	{ "cdf_B",		&bench_xeq,	OP_MON | OP_cdf_B,	"4", NULL, NULL, "0.3", "12" },
+	{ "qf_B",		&bench_xeq,	OP_MON | OP_qf_B,	"0.9", NULL, NULL, "0.3", "12" },
+};
+#define NUM_BENCH_CASES	(sizeof(bench_cases) / sizeof(bench_cases[0]))
+
+static unsigned long long int bench_ns(void)
+{
+	struct timespec t;
+
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return (unsigned long long int) t.tv_sec * 1000000000ULL + t.tv_nsec;
+}
+
+static void bench_run(unsigned int n)
+{
+	unsigned long long int iterations = 1, best = 0, instructions;
+	unsigned long long int i, t;
+	int trial;
+
+	bench_args(bench_cases[n].x, bench_cases[n].y, bench_cases[n].z);
+	if (bench_cases[n].j != NULL) {
+		decNumber p;
+		decNumberFromString(&p, bench_cases[n].j, &Ctx);
+		setRegister(regJ_idx, &p);
+	}
+	if (bench_cases[n].k != NULL) {
+		decNumber p;
+		decNumberFromString(&p, bench_cases[n].k, &Ctx);
+		setRegister(regK_idx, &p);
+	}
+	BenchOp = bench_cases[n].op;
+
+	/* Calibrate */
+	for (;;) {
+		t = bench_ns();
+		for (i = 0; i < iterations; i++)
+			bench_cases[n].f();
+		t = bench_ns() - t;
+		if (t >= BENCH_TRIAL_NS)
+			break;
+		iterations *= t < BENCH_TRIAL_NS / 16 ? 16 : 2;
+	}
+
+	instruction_count = 0;
+	for (trial = 0; trial < BENCH_TRIALS; trial++) {
+		t = bench_ns();
+		for (i = 0; i < iterations; i++)
+			bench_cases[n].f();
+		t = bench_ns() - t;
+		if (trial == 0 || t < best)
+			best = t;
+	}
+	instructions = instruction_count / (iterations * BENCH_TRIALS);
+
+	printf("%-18s %s %12.0f ns/op", bench_cases[n].name,
+		is_dblmode() ? "DP" : "SP", (double) best / iterations);
+	if (BenchOp != 0)
+		printf(" %8llu instructions", instructions);
+	if (Error != ERR_NONE || last_error != ERR_NONE)
+		printf(" (error %d)", Error != ERR_NONE ? Error : last_error);
+	putchar('\n');
+	fflush(stdout);
+	Error = ERR_NONE;
+	last_error = ERR_NONE;
+}
+
+static int bench_selected(unsigned int n, int argc, char *argv[])
+{
+	int i;
+
+	if (argc == 0)
+		return 1;
+	for (i = 0; i < argc; i++)
+		if (strcmp(argv[i], bench_cases[n].name) == 0)
+			return 1;
+	return 0;
+}
+
+int benchmark(int argc, char *argv[])
+{
+	unsigned int n;
+	int dbl;
+
+	reset();
+	init_34s();
+	bench_matrix_init();
+
+	for (dbl = 0; dbl < 2; dbl++) {
+		xeq(OP_NIL | (dbl ? OP_DBLON : OP_DBLOFF));
+		bench_program();
+		for (n = 0; n < NUM_BENCH_CASES; n++)
+			if (bench_selected(n, argc, argv))
+				bench_run(n);
+	}
+	return 0;
+}
@@ -0,0 +1,286 @@
+/* This file is part of 34S.
+ * 
+ * 34S is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * 34S is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with 34S.  If not, see <http://www.gnu.org/licenses/>.
+ * 
+ * 
+ * This file is automatically generated.
+ * Changes will not be preserved.
+ */
+
+#ifndef CATALOGUES_H_INCLUDED
+#define CATALOGUES_H_INCLUDED
+
+static const unsigned char opcode_breaks[KIND_MAX] = {
+	52, 208, 153, 48, 12, 153, 48, 
+};
+
+/* With STOPW */
+#define SIZE_catalogue 105
+static const unsigned char catalogue[] = {
+	0x47, 0x1b, 0x46, 0xa0, 0xc1, 0x63,
+	0x58, 0xe4, 0x18, 0xa2, 0x3c, 0x99,
+	0x16, 0xfc, 0x7d, 0x48, 0x72, 0x21,
+	0x09, 0x84, 0x4f, 0x93, 0xf6, 0x4d,
+	0x16, 0x47, 0x50, 0x56, 0xdd, 0x31,
+	0x4c, 0x92, 0x37, 0x15, 0xc6, 0x6d,
+	0x5b, 0x66, 0x8b, 0x20, 0x73, 0x58,
+	0x56, 0xe1, 0xc4, 0x45, 0x5d, 0x16,
+	0xa9, 0x35, 0x64, 0x9a, 0x76, 0x99,
+	0xa4, 0x64, 0x1b, 0xc7, 0x2c, 0xc3,
+	0x6f, 0x5c, 0x14, 0x8b, 0x18, 0x41,
+	0xf1, 0x7c, 0x4f, 0x14, 0x42, 0xd2,
+	0xa3, 0x0b, 0x21, 0x40, 0x8a, 0x37,
+	0x09, 0x94, 0x70, 0xc3, 0x56, 0x0c,
+	0xca, 0x46, 0x11, 0x74, 0x65, 0x1b,
+	0x6f, 0x8a, 0xc7, 0x1d, 0x8f, 0x28,
+	0x09, 0xeb, 0x28, 0xaa, 0x27, 0xec,
+	0x9b, 0x1e, 0xcb, 0xb3, 0x2c, 0xdb,
+	0x3a, 0xc8, 0x28, 0x4a, 0xb6, 0xa5,
+	0x34, 0x6b, 0x5a, 0xe6, 0xad, 0xac,
+	0x70, 0x18, 0xc4, 0x41, 0xd6, 0x6c,
+	0x9d, 0x05, 0xf5, 0x7a, 0x6c, 0x40,
+};
+
+#define SIZE_program_xfcn 126
+static const unsigned char program_xfcn[] = {
+	0x47, 0x1b, 0x46, 0xa3, 0x05, 0x30,
+	0x58, 0xd6, 0x3b, 0x07, 0x41, 0x8a,
+	0x23, 0xc9, 0x91, 0x6f, 0xdc, 0xf2,
+	0x59, 0xce, 0x1f, 0x52, 0x1c, 0x88,
+	0x42, 0x61, 0x13, 0xe4, 0xfd, 0x93,
+	0x45, 0xb0, 0x84, 0x75, 0x05, 0x6d,
+	0xd3, 0x14, 0xc9, 0x23, 0x71, 0x5c,
+	0x66, 0xd5, 0xb6, 0x68, 0xb2, 0x07,
+	0x35, 0x85, 0x6e, 0x09, 0x47, 0x11,
+	0x15, 0x74, 0x5a, 0xa4, 0xd5, 0x92,
+	0xc2, 0xf0, 0xc6, 0x9d, 0xa6, 0x60,
+	0x9a, 0x46, 0x41, 0xbc, 0x60, 0x5c,
+	0xb3, 0x0d, 0xbd, 0x70, 0x52, 0x2c,
+	0x60, 0x95, 0xbf, 0xf0, 0x14, 0x1f,
+	0x00, 0xc0, 0xb1, 0x7c, 0x1b, 0x13,
+	0xc5, 0x06, 0x84, 0x2d, 0x2a, 0xc0,
+	0xcc, 0x2c, 0x13, 0x21, 0x28, 0xdc,
+	0x26, 0x51, 0xc3, 0x0d, 0x58, 0x33,
+	0x29, 0x18, 0x45, 0xd1, 0x94, 0x6d,
+	0xbe, 0x2b, 0x1c, 0x76, 0x3c, 0xa0,
+	0x27, 0xac, 0xa2, 0xa8, 0x9f, 0xb2,
+	0x6c, 0x7b, 0x2e, 0xcc, 0xb3, 0x6c,
+	0xeb, 0x20, 0xa1, 0x2a, 0xda, 0x94,
+	0xd1, 0xad, 0x6b, 0x9a, 0xb6, 0xb1,
+	0xc0, 0x63, 0x11, 0x07, 0x5d, 0xd6,
+	0x6c, 0x9d, 0x05, 0xf5, 0x7a, 0x6c,
+	0x5d, 0x80,
+};
+
+#define SIZE_cplx_catalogue 25
+static const unsigned char cplx_catalogue[] = {
+	0x7c, 0x68, 0x9c, 0xb2, 0x12, 0x3d,
+	0x0f, 0x31, 0x0d, 0xeb, 0x7c, 0xa0,
+	0x68, 0x1e, 0x77, 0x7a, 0xa7, 0xf8,
+	0x29, 0xe0, 0x7f, 0xde, 0xc7, 0xb9,
+	0xf0, 0xa7, 0x2c, 0x29, 0xfa, 0x09,
+	0x79, 0x40,
+};
+
+#define SIZE_stats_catalogue 17
+static const unsigned char stats_catalogue[] = {
+	0x18, 0x05, 0xc1, 0xa0, 0x5d, 0x17,
+	0xc9, 0x71, 0x58, 0x61, 0x16, 0x85,
+	0x95, 0xe0, 0x54, 0x17, 0x85, 0x51,
+	0x4c, 0x57, 0x5e, 0x80,
+};
+
+#define SIZE_sums_catalogue 14
+static const unsigned char sums_catalogue[] = {
+	0x14, 0x44, 0xb1, 0x34, 0x4a, 0x13,
+	0x84, 0xc1, 0x20, 0x45, 0x11, 0x04,
+	0xf1, 0x1c, 0x49, 0x11, 0x85, 0x00,
+};
+
+#define SIZE_prob_catalogue 54
+static const unsigned char prob_catalogue[] = {
+	0x54, 0xd5, 0x25, 0xc1, 0x54, 0x5a,
+	0x16, 0x75, 0xdd, 0x69, 0x54, 0x14,
+	0xf5, 0xbd, 0x51, 0x52, 0x56, 0xd5,
+	0x29, 0x4b, 0x57, 0x15, 0xb5, 0xcd,
+	0x5d, 0x58, 0x96, 0x15, 0xd5, 0x63,
+	0x59, 0x56, 0x45, 0xd9, 0x66, 0x57,
+	0xd5, 0xe5, 0xd1, 0x60, 0x56, 0x55,
+	0x85, 0xc9, 0x5a, 0x55, 0x95, 0x55,
+	0xc5, 0x57, 0x51, 0x96, 0xc5, 0x1d,
+	0x48, 0x53, 0x54, 0xc5, 0xb9, 0x4e,
+	0x5a, 0x94, 0x05, 0x11, 0x45, 0x50,
+	0xd6, 0xb0,
+};
+
+#define SIZE_int_catalogue 60
+static const unsigned char int_catalogue[] = {
+	0x47, 0x30, 0x53, 0x07, 0x07, 0x41,
+	0x9c, 0xf2, 0x59, 0xce, 0x10, 0xb0,
+	0x84, 0x75, 0x05, 0x6d, 0xda, 0x26,
+	0xe0, 0x94, 0xc2, 0xf0, 0xc6, 0x9d,
+	0xa6, 0x60, 0x9a, 0x46, 0xf1, 0x81,
+	0x72, 0xcc, 0x36, 0xf4, 0x95, 0xbf,
+	0xf0, 0x14, 0x1f, 0x00, 0xc0, 0xb0,
+	0x61, 0xa1, 0x0b, 0xc0, 0xf0, 0x4c,
+	0x85, 0x94, 0x0d, 0x4c, 0xa4, 0x6d,
+	0xbe, 0x2b, 0x1c, 0x7b, 0x28, 0xaa,
+	0xb2, 0x6c, 0x7b, 0x2e, 0xcc, 0xb3,
+	0x6c, 0xeb, 0x20, 0xab, 0x4d, 0x11,
+	0x07, 0x5d, 0xd8,
+};
+
+#define SIZE_test_catalogue 38
+static const unsigned char test_catalogue[] = {
+	0xc2, 0xb0, 0x9c, 0x9c, 0xf0, 0x2f,
+	0xcb, 0xdb, 0xde, 0xfb, 0xbf, 0x6f,
+	0xc2, 0xf2, 0xf6, 0xbe, 0x2f, 0xab,
+	0xe7, 0x39, 0x34, 0xcb, 0xbc, 0x42,
+	0xe5, 0x27, 0x4d, 0xa2, 0xe0, 0xbe,
+	0x2e, 0x8d, 0x42, 0xe4, 0xd0, 0x3f,
+	0xad, 0x2b, 0x4c, 0xd5, 0x35, 0xad,
+	0x1b, 0x56, 0xd4, 0x2d, 0xcf, 0xf0,
+};
+
+#define SIZE_prog_catalogue 93
+static const unsigned char prog_catalogue[] = {
+	0xb6, 0x4d, 0x1c, 0xf0, 0x79, 0x1d,
+	0x47, 0x81, 0xc8, 0x74, 0x2a, 0x32,
+	0xbb, 0x88, 0x42, 0xb7, 0xae, 0x01,
+	0xba, 0xa4, 0xbd, 0x4e, 0x0b, 0xae,
+	0xec, 0xcd, 0xf3, 0x4c, 0xd7, 0x38,
+	0xce, 0xb3, 0x63, 0x32, 0xe3, 0xb7,
+	0xee, 0x1c, 0x70, 0xe7, 0x3a, 0x4e,
+	0xc3, 0xa0, 0xed, 0xc7, 0x8d, 0xe3,
+	0x77, 0x1d, 0x0d, 0x0d, 0xc3, 0xa8,
+	0x70, 0x3a, 0xf1, 0xbb, 0x14, 0xe5,
+	0x37, 0xc7, 0x63, 0x34, 0x6d, 0x2c,
+	0x4a, 0xf2, 0xc8, 0xb0, 0x39, 0x8e,
+	0x43, 0x84, 0xe2, 0x38, 0xed, 0x83,
+	0x48, 0x37, 0xb1, 0x0c, 0x0a, 0xd8,
+	0xa9, 0xc5, 0x43, 0xa3, 0x2e, 0xb4,
+	0xad, 0x71, 0x22, 0xb8, 0xad, 0xc4,
+	0x72, 0x83, 0xf3, 0x2f, 0xcc, 0xf3,
+	0xb3, 0xd7, 0x2d, 0x3d, 0x8f, 0x7c,
+	0xc0, 0xfd, 0x3e, 0x4f, 0xa3, 0xe0,
+	0xfb, 0xcb, 0x80,
+};
+
+#define SIZE_mode_catalogue 54
+static const unsigned char mode_catalogue[] = {
+	0x29, 0x48, 0xc2, 0x90, 0x8b, 0xc3,
+	0x46, 0x63, 0xbc, 0xee, 0x1f, 0x88,
+	0x01, 0xfc, 0x7c, 0xbc, 0x89, 0x81,
+	0x8c, 0xcf, 0x24, 0x49, 0xc2, 0x6c,
+	0x62, 0x19, 0x49, 0x32, 0x48, 0x9a,
+	0x19, 0x31, 0xa2, 0x10, 0x83, 0xc7,
+	0xf1, 0x62, 0x20, 0x87, 0x32, 0x0a,
+	0x63, 0x10, 0xc7, 0x32, 0x4a, 0x73,
+	0x14, 0xc6, 0x23, 0x8c, 0xe0, 0xe0,
+	0x39, 0xc6, 0x48, 0x62, 0x14, 0x8d,
+	0xbf, 0x90, 0x14, 0x00, 0x99, 0xcc,
+	0xb3, 0x10,
+};
+
+#define SIZE_alpha_catalogue 14
+static const unsigned char alpha_catalogue[] = {
+	0x0d, 0x4a, 0xc2, 0x80, 0x9e, 0xb2,
+	0x8a, 0xa2, 0x7e, 0xc7, 0xb2, 0xec,
+	0xcb, 0x36, 0xce, 0x28, 0x4a, 0xb0,
+};
+
+#define SIZE_conv_catalogue 88
+static const unsigned char conv_catalogue[] = {
+	0xda, 0xdb, 0x8c, 0x8a, 0x2b, 0x2d,
+	0xdd, 0x37, 0x27, 0x39, 0x31, 0x33,
+	0x11, 0x16, 0x05, 0xdc, 0xde, 0x19,
+	0x1d, 0x1b, 0x13, 0x15, 0x0d, 0x0f,
+	0x8d, 0x08, 0x8f, 0x0a, 0x2a, 0x2c,
+	0x47, 0x43, 0x45, 0x17, 0x3f, 0x30,
+	0x32, 0x34, 0x04, 0x00, 0x02, 0x06,
+	0x26, 0x22, 0x20, 0x28, 0x24, 0x35,
+	0x2f, 0x01, 0x23, 0x10, 0x0c, 0x0e,
+	0x21, 0x12, 0x14, 0x3b, 0x18, 0x1a,
+	0x1c, 0x1e, 0x29, 0x2e, 0x09, 0x36,
+	0x38, 0x3e, 0x3a, 0x3c, 0x40, 0x25,
+	0xdf, 0x3d, 0x8b, 0x8e, 0x03, 0x07,
+	0x4b, 0x49, 0x41, 0x0b, 0x4a, 0x48,
+	0x46, 0x42, 0x44, 0x1f,
+};
+
+#define SIZE_matrix_catalogue 20
+static const unsigned char matrix_catalogue[] = {
+	0x66, 0xdd, 0x53, 0x64, 0xd8, 0x35,
+	0xdd, 0x33, 0x6d, 0x95, 0x72, 0x59,
+	0x67, 0x21, 0xd2, 0x72, 0x99, 0xa6,
+	0x71, 0xcc, 0x75, 0x19, 0x96, 0x61,
+	0x97,
+};
+
+#define SIZE_alpha_symbols 19
+static const char alpha_symbols[] = {
+	0054, 0072, 0073, 0047, 0042, 0052, 0100, 0137,
+	0176, 0045, 0044, 0014, 0036, 0037, 0216, 0256,
+	0222, 0140, 0043,
+};
+
+#define SIZE_alpha_compares 10
+static const char alpha_compares[] = {
+	0074, 0011, 0075, 0035, 0012, 0076, 0133, 0135,
+	0173, 0175,
+};
+
+#define SIZE_alpha_arrows 9
+static const char alpha_arrows[] = {
+	0015, 0016, 0020, 0017, 0003, 0004, 0237, 0136,
+	0177,
+};
+
+#define SIZE_alpha_superscripts 11
+static const char alpha_superscripts[] = {
+	0005, 0232, 0200, 0024, 0234, 0001, 0031, 0002,
+	0032, 0235, 0220,
+};
+
+#define SIZE_alpha_subscripts 26
+static const char alpha_subscripts[] = {
+	0270, 0005, 0271, 0272, 0232, 0200, 0327, 0230,
+	0273, 0024, 0206, 0274, 0367, 0033, 0275, 0276,
+	0223, 0277, 0201, 0213, 0234, 0214, 0231, 0235,
+	0220, 0233,
+};
+
+#define SIZE_alpha_letters 40
+static const char alpha_letters[] = {
+	0300, 0301, 0302, 0303, 0210, 0304, 0305, 0306,
+	0307, 0204, 0310, 0311, 0312, 0313, 0236, 0314,
+	0315, 0316, 0317, 0320, 0321, 0322, 0323, 0324,
+	0025, 0325, 0326, 0030, 0330, 0331, 0332, 0333,
+	0334, 0001, 0031, 0002, 0335, 0032, 0336, 0337,
+};
+
+#define SIZE_alpha_letters_lower 40
+static const char alpha_letters_lower[] = {
+	0340, 0341, 0342, 0343, 0211, 0344, 0345, 0346,
+	0347, 0205, 0350, 0351, 0352, 0353, 0236, 0354,
+	0355, 0356, 0357, 0360, 0361, 0362, 0363, 0364,
+	0026, 0365, 0366, 0030, 0370, 0371, 0372, 0373,
+	0374, 0001, 0031, 0002, 0375, 0032, 0376, 0377,
+};
+
+/* Total number of catalogue entries 620
+ * Total number of conversion entries 88
+ * Total number of alpha entries 155
+ */
+#endif
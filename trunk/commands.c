@@ -71,6 +71,13 @@
 #define IRA(x)		NOFN
 #endif
 
+/* Distributions computed in C on the emulators, see features.h */
+#ifdef NATIVE_DISTRIBUTIONS
+#define NMR(name)	& (native_ ## name)
+#else
+#define NMR(name)	XMR(name)
+#endif
+
 
 #ifdef SHORT_POINTERS
 #ifndef COMMANDS_PASS
@@ -199,17 +206,17 @@ const struct monfunc monfuncs[ NUM_MONADIC ] = {
 	FUNC(OP_ERF,	XMR(ERF),		NOFN,		NOFN,		"erf",		CNULL)
 	FUNC(OP_ERFC,	XMR(ERFC),		NOFN,		NOFN,		"erfc",		CNULL)
 	FUNC(OP_pdf_Q,	XMR(PDF_Q), 		NOFN,		NOFN,		"\264(x)",	"phi(x)")
-	FUNC(OP_cdf_Q,	XMR(CDF_Q), 		NOFN,		NOFN,		"\224(x)",	"PHI(x)")
-	FUNC(OP_qf_Q,	XMR(QF_Q),  		NOFN,		NOFN,		"\224\235(p)",	"INV-PHI")
+	FUNC(OP_cdf_Q,	NMR(CDF_Q),		NOFN,		NOFN,		"\224(x)",	"PHI(x)")
+	FUNC(OP_qf_Q,	NMR(QF_Q),		NOFN,		NOFN,		"\224\235(p)",	"INV-PHI")
 	FUNC(OP_pdf_chi2, XMR(PDF_CHI2),	NOFN,		NOFN,		"\265\232\276",	"chi2-p")
-	FUNC(OP_cdf_chi2, XMR(CDF_CHI2),	NOFN,		NOFN,		"\265\232",	"CHI2")
-	FUNC(OP_qf_chi2,  XMR(QF_CHI2),		NOFN,		NOFN,		"\265\232INV",	"INV-CHI2")
+	FUNC(OP_cdf_chi2, NMR(CDF_CHI2),	NOFN,		NOFN,		"\265\232",	"CHI2")
+	FUNC(OP_qf_chi2,  NMR(QF_CHI2),		NOFN,		NOFN,		"\265\232INV",	"INV-CHI2")
 	FUNC(OP_pdf_T,	XMR(PDF_T),		NOFN,		NOFN,		"t\276(x)",	"t-p(x)")
-	FUNC(OP_cdf_T,	XMR(CDF_T),		NOFN,		NOFN,		"t(x)",		CNULL)
-	FUNC(OP_qf_T,	XMR(QF_T),		NOFN,		NOFN,		"t\235(p)",	"INV-t")
+	FUNC(OP_cdf_T,	NMR(CDF_T),		NOFN,		NOFN,		"t(x)",		CNULL)
+	FUNC(OP_qf_T,	NMR(QF_T),		NOFN,		NOFN,		"t\235(p)",	"INV-t")
 	FUNC(OP_pdf_F,	XMR(PDF_F),		NOFN,		NOFN,		"F\276(x)",	"F-p(x)")
-	FUNC(OP_cdf_F,	XMR(CDF_F),		NOFN,		NOFN,		"F(x)",		CNULL)
-	FUNC(OP_qf_F,	XMR(QF_F),		NOFN,		NOFN,		"F\235(p)",	"INV-F")
+	FUNC(OP_cdf_F,	NMR(CDF_F),		NOFN,		NOFN,		"F(x)",		CNULL)
+	FUNC(OP_qf_F,	NMR(QF_F),		NOFN,		NOFN,		"F\235(p)",	"INV-F")
 	FUNC(OP_pdf_WB,	XMR(PDF_WEIB),		NOFN,		NOFN,		"Weibl\276",	"Weibl-p")
 	FUNC(OP_cdf_WB,	XMR(CDF_WEIB),		NOFN,		NOFN,		"Weibl",	CNULL)
 	FUNC(OP_qf_WB,	XMR(QF_WEIB),		NOFN,		NOFN,		"Weibl\235",	"INV-Weibl")
@@ -217,41 +224,41 @@ const struct monfunc monfuncs[ NUM_MONADIC ] = {
 	FUNC(OP_cdf_EXP,XMR(CDF_EXPON),		NOFN,		NOFN,		"Expon",	CNULL)
 	FUNC(OP_qf_EXP,	XMR(QF_EXPON),		NOFN,		NOFN,		"Expon\235",	"INV-Expon")
 	FUNC(OP_pdf_B,	XMR(PDF_BINOMIAL),	NOFN,		NOFN,		"Binom\276",	"Binom-p")
-	FUNC(OP_cdf_B,	XMR(CDF_BINOMIAL),	NOFN,		NOFN,		"Binom",	CNULL)
-	FUNC(OP_qf_B,	XMR(QF_BINOMIAL),	NOFN,		NOFN,		"Binom\235",	"INV-Binom")
+	FUNC(OP_cdf_B,	NMR(CDF_BINOMIAL),	NOFN,		NOFN,		"Binom",	CNULL)
+	FUNC(OP_qf_B,	NMR(QF_BINOMIAL),	NOFN,		NOFN,		"Binom\235",	"INV-Binom")
 	FUNC(OP_pdf_Plam, XMR(PDF_POISSON),	NOFN,		NOFN,		"Pois\252\276",	"Pois-p")
-	FUNC(OP_cdf_Plam, XMR(CDF_POISSON),	NOFN,		NOFN,		"Pois\252",	"Pois")
-	FUNC(OP_qf_Plam,  XMR(QF_POISSON),	NOFN,		NOFN,		"Pois\252\235",	"INV-Pois")
+	FUNC(OP_cdf_Plam, NMR(CDF_POISSON),	NOFN,		NOFN,		"Pois\252",	"Pois")
+	FUNC(OP_qf_Plam,  NMR(QF_POISSON),	NOFN,		NOFN,		"Pois\252\235",	"INV-Pois")
 	FUNC(OP_pdf_P,	XMR(PDF_POIS2),		NOFN,		NOFN,		"Poiss\276",	"Pois2-p")
-	FUNC(OP_cdf_P,	XMR(CDF_POIS2),		NOFN,		NOFN,		"Poiss",	"Pois2")
-	FUNC(OP_qf_P,	XMR(QF_POIS2),		NOFN,		NOFN,		"Poiss\235",	"INV-Pois2")
+	FUNC(OP_cdf_P,	NMR(CDF_POIS2),		NOFN,		NOFN,		"Poiss",	"Pois2")
+	FUNC(OP_qf_P,	NMR(QF_POIS2),		NOFN,		NOFN,		"Poiss\235",	"INV-Pois2")
 	FUNC(OP_pdf_G,	XMR(PDF_GEOM),		NOFN,		NOFN,		"Geom\276",	"Geom-p")
 	FUNC(OP_cdf_G,	XMR(CDF_GEOM),		NOFN,		NOFN,		"Geom",		CNULL)
 	FUNC(OP_qf_G,	XMR(QF_GEOM),		NOFN,		NOFN,		"Geom\235",	"INV-Geom")
 	FUNC(OP_pdf_N,	XMR(PDF_NORMAL),	NOFN,		NOFN,		"Norml\276",	"Norml-p")
-	FUNC(OP_cdf_N,	XMR(CDF_NORMAL),	NOFN,		NOFN,		"Norml",	CNULL)
-	FUNC(OP_qf_N,	XMR(QF_NORMAL),		NOFN,		NOFN,		"Norml\235",	"INV-Norml")
+	FUNC(OP_cdf_N,	NMR(CDF_NORMAL),	NOFN,		NOFN,		"Norml",	CNULL)
+	FUNC(OP_qf_N,	NMR(QF_NORMAL),		NOFN,		NOFN,		"Norml\235",	"INV-Norml")
 	FUNC(OP_pdf_LN,	XMR(PDF_LOGNORMAL),	NOFN,		NOFN,		"LgNrm\276",	"LgNorm-p")
-	FUNC(OP_cdf_LN,	XMR(CDF_LOGNORMAL),	NOFN,		NOFN,		"LgNrm",	CNULL)
-	FUNC(OP_qf_LN,	XMR(QF_LOGNORMAL),	NOFN,		NOFN,		"LgNrm\235",	"INV-LgNorm")
+	FUNC(OP_cdf_LN,	NMR(CDF_LOGNORMAL),	NOFN,		NOFN,		"LgNrm",	CNULL)
+	FUNC(OP_qf_LN,	NMR(QF_LOGNORMAL),	NOFN,		NOFN,		"LgNrm\235",	"INV-LgNorm")
 	FUNC(OP_pdf_LG,	XMR(PDF_LOGIT),		NOFN,		NOFN,		"Logis\276",	"Logis-p")
 	FUNC(OP_cdf_LG,	XMR(CDF_LOGIT),		NOFN,		NOFN,		"Logis",	CNULL)
 	FUNC(OP_qf_LG,	XMR(QF_LOGIT),		NOFN,		NOFN,		"Logis\235",	"INV-Logis")
 	FUNC(OP_pdf_C,	XMR(PDF_CAUCHY),	NOFN,		NOFN,		"Cauch\276",	"Cauch-p")
 	FUNC(OP_cdf_C,	XMR(CDF_CAUCHY),	NOFN,		NOFN,		"Cauch",	CNULL)
 	FUNC(OP_qf_C,	XMR(QF_CAUCHY),		NOFN,		NOFN,		"Cauch\235",	"INV-Cauch")
-	FUNC(OP_cdfu_Q,	XMR(CDFU_Q),		NOFN,		NOFN,		"\224\277(x)",	"Q-u")
-	FUNC(OP_cdfu_chi2, XMR(CDFU_CHI2),	NOFN,		NOFN,		"\265\232\277",	"CHI2-u")
-	FUNC(OP_cdfu_T,	XMR(CDFU_T),		NOFN,		NOFN,		"t\277(x)",	"t-u")
-	FUNC(OP_cdfu_F,	XMR(CDFU_F),		NOFN,		NOFN,		"F\277(x)",	"F-u")
+	FUNC(OP_cdfu_Q,	NMR(CDFU_Q),		NOFN,		NOFN,		"\224\277(x)",	"Q-u")
+	FUNC(OP_cdfu_chi2, NMR(CDFU_CHI2),	NOFN,		NOFN,		"\265\232\277",	"CHI2-u")
+	FUNC(OP_cdfu_T,	NMR(CDFU_T),		NOFN,		NOFN,		"t\277(x)",	"t-u")
+	FUNC(OP_cdfu_F,	NMR(CDFU_F),		NOFN,		NOFN,		"F\277(x)",	"F-u")
 	FUNC(OP_cdfu_WB, XMR(CDFU_WEIB),	NOFN,		NOFN,		"Weibl\277",	"Weibl-u")
 	FUNC(OP_cdfu_EXP, XMR(CDFU_EXPON),	NOFN,		NOFN,		"Expon\277",	"Expon-u")
-	FUNC(OP_cdfu_B,	XMR(CDFU_BINOMIAL),	NOFN,		NOFN,		"Binom\277",	"Binom-u")
-	FUNC(OP_cdfu_Plam, XMR(CDFU_POISSON),	NOFN,		NOFN,		"Pois\252\277",	"Pois-u")
-	FUNC(OP_cdfu_P,	XMR(CDFU_POIS2),	NOFN,		NOFN,		"Poiss\277",	"Pois2-u")
+	FUNC(OP_cdfu_B,	NMR(CDFU_BINOMIAL),	NOFN,		NOFN,		"Binom\277",	"Binom-u")
+	FUNC(OP_cdfu_Plam, NMR(CDFU_POISSON),	NOFN,		NOFN,		"Pois\252\277",	"Pois-u")
+	FUNC(OP_cdfu_P,	NMR(CDFU_POIS2),	NOFN,		NOFN,		"Poiss\277",	"Pois2-u")
 	FUNC(OP_cdfu_G,	XMR(CDFU_GEOM),		NOFN,		NOFN,		"Geom\277",	"Geom-u")
-	FUNC(OP_cdfu_N,	XMR(CDFU_NORMAL),	NOFN,		NOFN,		"Norml\277",	"Norml-u")
-	FUNC(OP_cdfu_LN, XMR(CDFU_LOGNORMAL),	NOFN,		NOFN,		"LgNrm\277",	"LgNrm-u")
+	FUNC(OP_cdfu_N,	NMR(CDFU_NORMAL),	NOFN,		NOFN,		"Norml\277",	"Norml-u")
+	FUNC(OP_cdfu_LN, NMR(CDFU_LOGNORMAL),	NOFN,		NOFN,		"LgNrm\277",	"LgNrm-u")
 	FUNC(OP_cdfu_LG, XMR(CDFU_LOGIT),	NOFN,		NOFN,		"Logis\277",	"Logis-u")
 	FUNC(OP_cdfu_C,	XMR(CDFU_CAUCHY),	NOFN,		NOFN,		"Cauch\277",	"Cauch-u")
 	FUNC(OP_xhat,	&stats_xhat,		NOFN,		NOFN,		"\031",		"FCSTx")
@@ -402,6 +409,9 @@ const struct dyfunc dyfuncs[ NUM_DYADIC ] = {
 	FUNC(OP_BESYN,	XDR(BES_YN),		XDC(CPX_YN),	NOFN,		"Yn",		CNULL)
 	FUNC(OP_BESKN,	XDR(BES_KN),		XDC(CPX_KN),	NOFN,		"Kn",		CNULL)
 #endif
+#ifdef BULK_RANDOM
+	FUNC(OP_MAT_RAN, &matrix_random,	NOFN,		NOFN,		"M.RAN",	CNULL)
+#endif
 #undef FUNC
 };
 
@@ -720,6 +730,7 @@ const struct niladic niladics[ NUM_NILADIC ] = {
 #ifdef INCLUDE_STOPWATCH
 	FUNC0(OP_STOPWATCH,	&stopwatch,		"STOPW",	CNULL)
 #endif
+	FUNC0(OP_DEI_NODE,	&op_dei_node,		"DENODE",	CNULL)
 #ifdef _DEBUG
 	FUNC0(OP_DEBUG,		XNIL(DBG),		"DBG",		CNULL)
 #endif
@@ -599,6 +599,9 @@ static s_opcode matrix_catalogue[] = {
 #ifdef MATRIX_LU_DECOMP
 	MON(OP_MAT_LU,		"M.LU")
 #endif
+#ifdef BULK_RANDOM
+	DYA(OP_MAT_RAN,		"M.RAN")
+#endif
 #ifdef SILLY_MATRIX_SUPPORT
 	NILIC(OP_MAT_ZERO,	"M.ZERO")
 	NILIC(OP_MAT_IDENT,	"M.IDEN")
@@ -448,6 +448,10 @@ static void output(FILE *fm, const char *name, const decNumber *d) {
 	license(fc, "/* ", " * ", " */");
 	num = ((d->digits+DECDPUN-1)/DECDPUN);
 	fprintf(fc,	"#include \"decNumber/decNumber.h\"\n"
+			"\n"
+			"#if DECDPUN != %d\n"
+			"#error \"Constant generated for a different DECDPUN\"\n"
+			"#endif\n"
 			"\n"
 			"const struct {\n"
 			"\tint32_t digits;\n"
@@ -460,7 +464,7 @@ static void output(FILE *fm, const char *name, const decNumber *d) {
 			"\t%d,\n"
 			"\t%u,\n"
 			"\t{ ",
-		num, name, d->digits, d->exponent, d->bits);
+		DECDPUN, num, name, d->digits, d->exponent, d->bits);
 	for (i=0; i<num; i++) {
 		if (i != 0)
 			fprintf(fc, ", ");
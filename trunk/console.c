@@ -21,6 +21,14 @@
 #include <stdio.h>
 #include <ctype.h>
 #include <string.h>
+#ifdef WIN32
+#include <time.h>
+#else
+#include <sys/time.h>
+#endif
+#ifdef MULTI_INSTANCE
+#include <pthread.h>
+#endif
 
 #include "xeq.h" 
 #include "keys.h"
@@ -29,6 +37,8 @@
 #include "int.h"
 #include "consts.h"
 #include "storage.h"
+#include "stats.h"
+#include "profile.h"
 
 #include "catalogues.h"
 
@@ -41,8 +51,9 @@
 #define CH_COPY		'X'
 #define CH_PASTE	'V'
 
-unsigned long long int instruction_count = 0;
-int view_instruction_counter = 0;
+INSTANCE unsigned long long int instruction_count = 0;
+INSTANCE int view_instruction_counter = 0;
+INSTANCE int last_error = ERR_NONE;
 
 /*
  *  PC keys to calculator keys
@@ -276,6 +287,19 @@ static const struct {
 #undef XE
 };
 #define num_xrom_entry_points	(sizeof(xrom_entry_points) / sizeof(*xrom_entry_points))
+
+/*
+ *  Name of the XLBL at an XROM address or NULL
+ */
+const char *xrom_entry_name(unsigned int pc)
+{
+	unsigned int i;
+
+	for (i = 0; i < num_xrom_entry_points; i++)
+		if (addrXROM(xrom_entry_points[i].address) == pc)
+			return xrom_entry_points[i].name;
+	return NULL;
+}
 	
 static const struct {
 	opcode op;
@@ -343,9 +367,9 @@ static void dump_code(unsigned int pc, unsigned int max, int annotate) {
 		}
 		if (annotate) {
 			extern const unsigned short int xrom_targets[];
-			for (i=0; i<num_xrom_entry_points; i++)
-				if (addrXROM(xrom_entry_points[i].address) == pc)
-					printf("\t\t\tXLBL %s", xrom_entry_points[i].name);
+			const char *xlbl = xrom_entry_name(pc);
+			if (xlbl != NULL)
+				printf("\t\t\tXLBL %s", xlbl);
 			for (i=0; i<num_xrom_labels; i++)
 				if (xrom_labels[i].op == op)
 					printf("\t\t\t%s", xrom_labels[i].name);
@@ -489,13 +513,536 @@ void shutdown_calc( void )
 
 
 /*
- *  Dummies
+ *  Batch mode: run scripted jobs without curses.
+ *
+ *  calc batch [-s statefile] [-p program] [-d datafile] [-m maxsteps]
+ *             [-r] [-j threads] [jobfile]
+ *
+ *  Each line of the job file (or stdin) names a label to execute followed
+ *  by the inputs: Rnn=value seeds a register, alpha=text sets Alpha and
+ *  any other value is pushed onto the stack, so the last one ends up in X.
+ *  Labels are A-D, 00-99 or up to three characters for an alpha label,
+ *  optionally quoted as 'ABC'.  Every job starts from the same RAM
+ *  image and produces one JSON line with the results.
+ *
+ *  The data file holds x,y pairs for the statistics registers, one per line
+ *  and separated by commas or blanks (a missing y counts as zero).  They
+ *  are loaded before the first job, as if by sigma+ in that order.
+ *
+ *  Every job normally sees the same random numbers.  With -r job n draws
+ *  from a stream of its own that starts n * 2^64 steps along the generator.
+ *
+ *  With MULTI_INSTANCE, -j runs the jobs on several threads, each with a
+ *  calculator of its own.  The results come out in the order the jobs
+ *  finish.
+ */
+static unsigned long long int batch_limit;
+static FILE *batch_in;
+static int batch_jobs;
+#ifdef BULK_RANDOM
+static int batch_streams;
+#endif
+
+#ifdef MULTI_INSTANCE
+static pthread_mutex_t batch_mutex = PTHREAD_MUTEX_INITIALIZER;
+static CALC_INSTANCE batch_start;
+#define batch_lock()	flockfile(stdout)
+#define batch_unlock()	funlockfile(stdout)
+#else
+#define batch_lock()
+#define batch_unlock()
+#endif
+
+/*
+ *  Wall clock in microseconds
  */
-int is_key_pressed(void) 
+static unsigned long long int batch_usec(void)
+{
+#ifdef WIN32
+	return (unsigned long long int) clock() * 1000000 / CLOCKS_PER_SEC;
+#else
+	struct timeval t;
+
+	gettimeofday(&t, NULL);
+	return (unsigned long long int) t.tv_sec * 1000000 + t.tv_usec;
+#endif
+}
+
+static int batch_load_program(const char *filename)
+{
+	unsigned char buffer[ 2 * NUMPROG_LIMIT + 8 ];
+	int size, words = 0;
+	FILE *f;
+	const char *ext = strrchr(filename, '.');
+
+	if (ext == NULL || strcmp(ext, ".dat") != 0) {
+		// Source file, needs the assembler
+		return import_textfile(filename) != 0;
+	}
+	f = fopen(filename, "rb");
+	if (f == NULL) {
+		perror(filename);
+		return 1;
+	}
+	size = (int) fread(buffer, 2, sizeof(buffer) / 2, f);
+	fclose(f);
+	if (size >= 2)
+		words = buffer[3] * 256 + buffer[2];
+	if (words != size - 3) {
+		fprintf(stderr, "%s: bad program file size %d\n", filename, size);
+		return 1;
+	}
+	if (append_program((s_opcode *) (buffer + 4), words) != 0) {
+		fprintf(stderr, "%s: program doesn't fit\n", filename);
+		return 1;
+	}
+	update_program_bounds(1);
+	return 0;
+}
+
+#ifdef SIGMA_BULK
+static int batch_load_data(const char *filename)
+{
+	static const char separators[] = ", ;\t\r\n";
+	SIGMA_BULK_DATA *b = (SIGMA_BULK_DATA *) malloc(sizeof(SIGMA_BULK_DATA));
+	FILE *f = strcmp(filename, "-") == 0 ? stdin : fopen(filename, "r");
+	char line[1024];
+	int lineno = 0, err = 0;
+
+	if (f == NULL) {
+		perror(filename);
+		free(b);
+		return 1;
+	}
+	if (b == NULL) {
+		fprintf(stderr, "out of memory\n");
+		err = 1;
+	}
+	else
+		sigma_bulk_start(b);
+	while (! err && fgets(line, sizeof(line), f) != NULL) {
+		char *tok[3], *p;
+		decNumber xy[2];
+		int i, n = 0;
+
+		lineno++;
+		for (p = strtok(line, separators); p != NULL; p = strtok(NULL, separators))
+			if (n < 3)
+				tok[n++] = p;
+		if (n == 0 || *tok[0] == '#')
+			continue;
+		decNumberZero(&xy[1]);
+		for (i = 0; i < n; i++) {
+			decNumberFromString(&xy[i], tok[i], &Ctx);
+			if (decNumberIsNaN(&xy[i]) && strcmp(tok[i], "NaN") != 0)
+				break;
+		}
+		if (i < n || n > 2) {
+			fprintf(stderr, "%s:%d: bad data\n", filename, lineno);
+			err = 1;
+		}
+		else
+			sigma_bulk_add(b, &xy[0], &xy[1]);
+	}
+	if (! err && sigma_bulk_finish(b)) {
+		fprintf(stderr, "%s: no room for the statistics registers\n", filename);
+		err = 1;
+	}
+	if (f != stdin)
+		fclose(f);
+	free(b);
+	return err;
+}
+#endif
+
+static opcode batch_label(const char *s)
+{
+	opcode op = OP_DBL + (DBL_XEQ << DBL_SHIFT);
+	int i;
+
+	if (s[0] >= 'A' && s[0] <= 'D' && s[1] == '\0')
+		return RARG(RARG_XEQ, 100 + s[0] - 'A');
+	if (isdigit(s[0]) && (s[1] == '\0' || (isdigit(s[1]) && s[2] == '\0')))
+		return RARG(RARG_XEQ, atoi(s));
+	if (*s == '\'')
+		s++;
+	for (i = 0; i < 3 && s[i] != '\'' && s[i] != '\0'; i++)
+		op |= (unsigned char) s[i] << (i == 0 ? 0 : 8 * (i + 1));
+	if (i == 0 || (s[i] != '\0' && (s[i] != '\'' || s[i + 1] != '\0')))
+		return 0;
+	return op;
+}
+
+static int batch_set(int index, const char *s)
 {
+	decNumber x;
+
+	decNumberFromString(&x, s, &Ctx);
+	if (decNumberIsNaN(&x) && strcmp(s, "NaN") != 0)
+		return 1;
+	if (is_intmode()) {
+		int sgn;
+		const unsigned long long int v = dn_to_ull(&x, &sgn);
+		set_reg_n_int_sgn(index, v, sgn);
+	}
+	else
+		setRegister(index, &x);
 	return 0;
 }
 
+static void batch_string(const char *s)
+{
+	putchar('"');
+	for (; *s != '\0'; s++) {
+		const unsigned char c = *s;
+		if (c == '"' || c == '\\')
+			printf("\\%c", c);
+		else if (c < ' ' || c >= 0x7f)
+			printf("\\u%04x", c);
+		else
+			putchar(c);
+	}
+	putchar('"');
+}
+
+static void batch_register(int index)
+{
+	char buf[64];
+
+	if (is_intmode()) {
+		int sgn;
+		const unsigned long long int v = get_reg_n_int_sgn(index, &sgn);
+		sprintf(buf, "%s%llu", sgn ? "-" : "", v);
+	}
+	else {
+		decNumber x;
+		decNumberToString(getRegister(&x, index), buf);
+	}
+	batch_string(buf);
+}
+
+static void batch_result(int job, const char *label, const char *status, int err, unsigned long long int usec)
+{
+	int i;
+
+	batch_lock();
+	printf("{\"job\":%d,\"label\":", job);
+	batch_string(label);
+	printf(",\"status\":\"%s\",\"error\":%d,\"message\":", status, err);
+	batch_string(err > 0 ? LastDisplayedText : "");
+	printf(",\"stack\":[");
+	for (i = 0; i < stack_size(); i++) {
+		if (i)
+			putchar(',');
+		batch_register(regX_idx + i);
+	}
+	printf("],\"lastx\":");
+	batch_register(regL_idx);
+	printf(",\"alpha\":");
+	batch_string(Alpha);
+	printf(",\"registers\":[");
+	for (i = 0; i < global_regs(); i++) {
+		if (i)
+			putchar(',');
+		batch_register(i);
+	}
+	printf("],\"instructions\":%llu,\"usec\":%llu}\n", instruction_count, usec);
+	batch_unlock();
+}
+
+/*
+ *  Split off the next blank separated word, strtok() isn't reentrant
+ */
+static char *batch_token(char **line)
+{
+	char *p = *line, *tok;
+
+	while (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n')
+		p++;
+	if (*p == '\0')
+		return NULL;
+	tok = p;
+	while (*p != '\0' && *p != ' ' && *p != '\t' && *p != '\r' && *p != '\n')
+		p++;
+	if (*p != '\0')
+		*p++ = '\0';
+	*line = p;
+	return tok;
+}
+
+static int batch_job(int job, char *line)
+{
+	char *label = batch_token(&line);
+	char *tok;
+	const char *status = "ok";
+	unsigned long long int t0;
+	opcode op;
+	int i, n = 0;
+	char *values[STACK_SIZE];
+
+	if (label == NULL || *label == '#')
+		return 0;
+	op = batch_label(label);
+	if (op == 0) {
+		batch_lock();
+		printf("{\"job\":%d,\"label\":", job);
+		batch_string(label);
+		printf(",\"status\":\"bad label\"}\n");
+		batch_unlock();
+		return 1;
+	}
+	while ((tok = batch_token(&line)) != NULL) {
+		int bad = 0;
+
+		if (tok[0] == 'R' && isdigit(tok[1]) && isdigit(tok[2]) && tok[3] == '=') {
+			const int r = (tok[1] - '0') * 10 + tok[2] - '0';
+			bad = r >= global_regs() || batch_set(r, tok + 4);
+		}
+		else if (strncmp(tok, "alpha=", 6) == 0) {
+			xset(Alpha, '\0', NUMALPHA + 1);
+			strncpy(Alpha, tok + 6, NUMALPHA);
+		}
+		else if (n < stack_size()) {
+			values[n++] = tok;
+		}
+		else
+			bad = 1;
+		if (bad) {
+			batch_lock();
+			printf("{\"job\":%d,\"label\":", job);
+			batch_string(label);
+			printf(",\"status\":\"bad input\",\"message\":");
+			batch_string(tok);
+			printf("}\n");
+			batch_unlock();
+			return 1;
+		}
+	}
+	for (i = 0; i < n; i++)
+		if (batch_set(regX_idx + n - 1 - i, values[i])) {
+			batch_lock();
+			printf("{\"job\":%d,\"label\":", job);
+			batch_string(label);
+			printf(",\"status\":\"bad input\",\"message\":");
+			batch_string(values[i]);
+			printf("}\n");
+			batch_unlock();
+			return 1;
+		}
+
+#ifdef BULK_RANDOM
+	if (batch_streams)
+		stats_random_jump(job, 64);
+#endif
+	last_error = ERR_NONE;
+	instruction_count = 0;
+	t0 = batch_usec();
+	xeq(op);
+	while (Running || Pause) {
+		Pause = 0;
+		xeqprog();
+		if (batch_limit != 0 && instruction_count >= batch_limit) {
+			set_running_off();
+			status = "timeout";
+			break;
+		}
+	}
+	PROFILE_STOP();
+	t0 = batch_usec() - t0;
+	if (last_error != ERR_NONE)
+		status = "error";
+	batch_result(job, label, status, last_error, t0);
+	return last_error != ERR_NONE;
+}
+
+/*
+ *  Fetch the next job, returns its number or zero at the end of the input
+ */
+static int batch_next(char *line, int size)
+{
+	int job = 0;
+
+#ifdef MULTI_INSTANCE
+	pthread_mutex_lock(&batch_mutex);
+#endif
+	if (fgets(line, size, batch_in) != NULL)
+		job = ++batch_jobs;
+#ifdef MULTI_INSTANCE
+	pthread_mutex_unlock(&batch_mutex);
+#endif
+	return job;
+}
+
+/*
+ *  Run jobs until the input is exhausted, each from the current RAM image
+ */
+static int batch_run(void)
+{
+	static INSTANCE TPersistentRam image;
+	static INSTANCE struct _state2 state2;
+	char line[1024];
+	int job, failed = 0;
+
+	image = PersistentRam;
+	state2 = State2;
+	while ((job = batch_next(line, sizeof(line))) != 0) {
+		PersistentRam = image;
+		State2 = state2;
+		xeq_init_contexts();
+		failed += batch_job(job, line);
+	}
+	return failed;
+}
+
+#ifdef MULTI_INSTANCE
+static void *batch_thread(void *arg)
+{
+	instance_load(&batch_start);
+	*(int *) arg = batch_run();
+	return NULL;
+}
+#endif
+
+static int batch(int argc, char *argv[])
+{
+	const char *statefile = NULL, *program = NULL;
+#ifdef SIGMA_BULK
+	const char *data = NULL;
+#endif
+#ifdef PROFILER
+	const char *profile = NULL;
+#endif
+	int threads = 1, failed = 0;
+	int i;
+
+	batch_limit = 100000000;
+	batch_in = stdin;
+	for (i = 0; i < argc && argv[i][0] == '-' && argv[i][1] != '\0'; i++) {
+		if (strcmp(argv[i], "-s") == 0 && i + 1 < argc)
+			statefile = argv[++i];
+		else if (strcmp(argv[i], "-p") == 0 && i + 1 < argc)
+			program = argv[++i];
+#ifdef SIGMA_BULK
+		else if (strcmp(argv[i], "-d") == 0 && i + 1 < argc)
+			data = argv[++i];
+#endif
+		else if (strcmp(argv[i], "-m") == 0 && i + 1 < argc)
+			batch_limit = strtoull(argv[++i], NULL, 0);
+#ifdef BULK_RANDOM
+		else if (strcmp(argv[i], "-r") == 0)
+			batch_streams = 1;
+#endif
+#ifdef MULTI_INSTANCE
+		else if (strcmp(argv[i], "-j") == 0 && i + 1 < argc && atoi(argv[i + 1]) > 0)
+			threads = atoi(argv[++i]);
+#endif
+#ifdef PROFILER
+		else if (strcmp(argv[i], "-P") == 0 && i + 1 < argc)
+			profile = argv[++i];
+#endif
+		else {
+			fprintf(stderr, "usage: calc batch [-s statefile] [-p program]"
+#ifdef SIGMA_BULK
+					" [-d datafile]"
+#endif
+					" [-m maxsteps]"
+#ifdef BULK_RANDOM
+					" [-r]"
+#endif
+#ifdef MULTI_INSTANCE
+					" [-j threads]"
+#endif
+#ifdef PROFILER
+					" [-P profile]"
+#endif
+					" [jobfile]\n");
+			return 2;
+		}
+	}
+	if (i < argc && strcmp(argv[i], "-") != 0) {
+		batch_in = fopen(argv[i], "r");
+		if (batch_in == NULL) {
+			perror(argv[i]);
+			return 2;
+		}
+	}
+
+	if (statefile != NULL)
+		load_statefile(statefile);
+	else
+		reset();
+	init_34s();
+	if (program != NULL && batch_load_program(program))
+		return 2;
+#ifdef SIGMA_BULK
+	if (data != NULL) {
+		if (strcmp(data, "-") == 0 && batch_in == stdin) {
+			fprintf(stderr, "calc batch: data and jobs can't both come from stdin\n");
+			return 2;
+		}
+		if (batch_load_data(data))
+			return 2;
+	}
+#endif
+	State2.runmode = 1;
+#ifdef PROFILER
+	Profiling = profile != NULL;
+#endif
+
+	if (threads == 1)
+		failed = batch_run();
+#ifdef MULTI_INSTANCE
+	else {
+		pthread_t *tid = (pthread_t *) malloc(threads * sizeof(pthread_t));
+		int *result = (int *) calloc(threads, sizeof(int));
+
+		if (tid == NULL || result == NULL) {
+			fprintf(stderr, "out of memory\n");
+			return 2;
+		}
+		instance_save(&batch_start);
+		for (i = 0; i < threads; i++)
+			if (pthread_create(tid + i, NULL, &batch_thread, result + i) != 0) {
+				perror("pthread_create");
+				threads = i;
+				break;
+			}
+		for (i = 0; i < threads; i++) {
+			pthread_join(tid[i], NULL);
+			failed += result[i];
+		}
+		free(tid);
+		free(result);
+	}
+#endif
+	if (batch_in != stdin)
+		fclose(batch_in);
+#ifdef PROFILER
+	if (profile != NULL) {
+		FILE *f = strcmp(profile, "-") == 0 ? stderr : fopen(profile, "w");
+
+		Profiling = 0;
+		if (f == NULL) {
+			perror(profile);
+			return 2;
+		}
+		profile_report(f);
+		if (f != stderr)
+			fclose(f);
+	}
+#endif
+	return failed != 0;
+}
+
+
+/*
+ *  Dummies
+ */
+int is_key_pressed(void)
+{
+	return batch_limit != 0 && instruction_count >= batch_limit;
+}
+
 int get_key(void)
 {
 	return 0;
@@ -549,6 +1096,10 @@ void flush_comm( void )
 
 
 
+#ifndef WIN32
+extern int benchmark(int argc, char *argv[]);	// bench.c
+#endif
+
 /*
  *  Main loop
  */
@@ -557,6 +1108,12 @@ int main(int argc, char *argv[]) {
 	int warm = 0;
 
 	xeq_init_contexts();
+	if (argc > 1 && strcmp(argv[1], "batch") == 0)
+		return batch(argc - 2, argv + 2);
+#ifndef WIN32
+	if (argc > 1 && strcmp(argv[1], "bench") == 0)
+		return benchmark(argc - 2, argv + 2);
+#endif
 	load_statefile( NULL );
 	if (argc > 1) {
 		if (argc == 2) {
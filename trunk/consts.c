@@ -0,0 +1,283 @@
+/* This file is part of 34S.
+ * 
+ * 34S is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * 34S is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with 34S.  If not, see <http://www.gnu.org/licenses/>.
+ * 
+ * 
+ * This file is automatically generated.
+ * Changes will not be preserved.
+ */
+
+#include "consts.h"
+
+#if BYTE_ORDER == BIG_ENDIAN
+#define B(b1,b2,b3,b4,b5,b6,b7,b8) {{ b1,b2,b3,b4,b5,b6,b7,b8 }}
+#else
+#define B(b1,b2,b3,b4,b5,b6,b7,b8) {{ b8,b7,b6,b5,b4,b3,b2,b1 }}
+#endif
+
+#if BYTE_ORDER == BIG_ENDIAN
+#define D(b1,b2,b3,b4,b5,b6,b7,b8,b9,b10,b11,b12,b13,b14,b15,b16) \
+       {{ b1,b2,b3,b4,b5,b6,b7,b8,b9,b10,b11,b12,b13,b14,b15,b16 }}
+#else
+#define D(b1,b2,b3,b4,b5,b6,b7,b8,b9,b10,b11,b12,b13,b14,b15,b16) \
+       {{ b16,b15,b14,b13,b12,b11,b10,b9,b8,b7,b6,b5,b4,b3,b2,b1 }}
+#endif
+
+/* Table of user visible constants
+ */
+const struct cnsts cnsts[] = {
+#if ! defined(REALBUILD) || defined(COMPILE_CATALOGUES)
+#define CNST(n, index, fn, alias) { index, fn, alias },
+#else
+#define CNST(n, index, fn, alias) { index, fn },
+#endif
+
+	CNST(OP_HALF, 0x00, "1/2", "HALF")
+	CNST(OP_PC_a, 0x01, "a", CNULL)
+	CNST(OP_PC_a0, 0x02, "a\270", "a0")
+	CNST(OP_PC_SM_luna, 0x03, "a\033", "SM_luna")
+	CNST(OP_PC_SM_terra, 0x04, "a\256", "SM_terra")
+	CNST(OP_PC_C, 0x05, "c", "C")
+	CNST(OP_PC_C1, 0x06, "c\271", "C1")
+	CNST(OP_PC_C2, 0x07, "c\272", "C2")
+	CNST(OP_PC_eV, 0x08, "e", "eV")
+	CNST(OP_CNSTE, 0x82, "eE", "CNSTE")
+	CNST(OP_PC_F, 0x09, "F", CNULL)
+	CNST(OP_PC_F_alpha, 0x83, "F\240", "F_alpha")
+	CNST(OP_PC_F_delta, 0x84, "F\243", "F_delta")
+	CNST(OP_PC_g, 0x0a, "g", CNULL)
+	CNST(OP_PC_G, 0x0b, "G", CNULL)
+	CNST(OP_PC_Go, 0x0c, "G\270", "Go")
+	CNST(OP_PC_catalan, 0x85, "G\273", "catalan")
+	CNST(OP_PC_Ge, 0x0d, "g\274", "Ge")
+	CNST(OP_PC_WGS_GM, 0x0e, "GM", "WGS_GM")
+	CNST(OP_PC_PLANK, 0x0f, "h", "PLANK")
+	CNST(OP_PC_hon2PI, 0x10, "\236", "hon2PI")
+	CNST(OP_PC_k, 0x11, "k", CNULL)
+	CNST(OP_PC_Jk, 0x12, "Kj", "Jk")
+	CNST(OP_PC_PlanckL, 0x13, "l\276", "PlanckL")
+	CNST(OP_PC_me, 0x14, "m\274", "me")
+	CNST(OP_PC_M_luna, 0x15, "M\033", "M_luna")
+	CNST(OP_PC_mn, 0x16, "m\275", "mn")
+	CNST(OP_PC_mp, 0x17, "m\276", "mp")
+	CNST(OP_PC_PlanckM, 0x18, "M\276", "PlanckM")
+	CNST(OP_PC_mu, 0x19, "m\277", "mu")
+	CNST(OP_PC_muc2, 0x1a, "m\277c\232", "muc2")
+	CNST(OP_PC_mMu, 0x1b, "m\231", "mMu")
+	CNST(OP_PC_M_sol, 0x1c, "M\216", "M_sol")
+	CNST(OP_PC_M_terra, 0x1d, "M\256", "M_terra")
+	CNST(OP_PC_Na, 0x1e, "N\327", "Na")
+	CNST(OP_NAN, 0x1f, "NaN", "NAN")
+	CNST(OP_PC_atm, 0x20, "p\270", "atm")
+	CNST(OP_PC_PlanckQ, 0x21, "q\276", "PlanckQ")
+	CNST(OP_PC_R, 0x22, "R", CNULL)
+	CNST(OP_PC_Re, 0x23, "r\274", "Re")
+	CNST(OP_PC_Rk, 0x24, "R\367", "Rk")
+	CNST(OP_PC_R_luna, 0x25, "R\033", "R_luna")
+	CNST(OP_PC_Rinf, 0x26, "R\233", "Rinf")
+	CNST(OP_PC_R_sol, 0x27, "R\216", "R_sol")
+	CNST(OP_PC_R_terra, 0x28, "R\256", "R_terra")
+	CNST(OP_PC_WGS_A, 0x29, "Sa", "WGS_A")
+	CNST(OP_PC_WGS_B, 0x2a, "Sb", "WGS_B")
+	CNST(OP_PC_WGS_E2, 0x2b, "Se\232", "WGS_E2")
+	CNST(OP_PC_WGS_ES2, 0x2c, "Se'\232", "WGS_ES2")
+	CNST(OP_PC_WGS_F, 0x2d, "Sf\235", "WGS_F")
+	CNST(OP_PC_t, 0x2e, "T\270", "t")
+	CNST(OP_PC_tp, 0x2f, "t\276", "tp")
+	CNST(OP_PC_PlanckTh, 0x30, "T\276", "PlanckTh")
+	CNST(OP_PC_Vm, 0x31, "V\033", "Vm")
+	CNST(OP_PC_Zo, 0x86, "Z\270", "Zo")
+	CNST(OP_PC_alpha, 0x32, "\240", "alpha")
+	CNST(OP_EULER, 0x87, "\242EM", "EULER")
+	CNST(OP_PC_gamP, 0x33, "\242\276", "gamP")
+	CNST(OP_PC_eps0, 0x88, "\244\270", "eps0")
+	CNST(OP_PC_lamC, 0x34, "\252\273", "lamC")
+	CNST(OP_PC_lamCn, 0x35, "\252\273\275", "lamCn")
+	CNST(OP_PC_lamCp, 0x36, "\252\273\276", "lamCp")
+	CNST(OP_PC_mu0, 0x89, "\253\270", "mu0")
+	CNST(OP_PC_muB, 0x37, "\253\230", "muB")
+	CNST(OP_PC_muE, 0x38, "\253\274", "muE")
+	CNST(OP_PC_mun, 0x39, "\253\275", "mun")
+	CNST(OP_PC_muP, 0x3a, "\253\276", "muP")
+	CNST(OP_PC_mu_u, 0x3b, "\253\277", "mu_u")
+	CNST(OP_PC_mumu, 0x3c, "\253\231", "mumu")
+	CNST(OP_PC_sigma, 0x3d, "\261\230", "sigma")
+	CNST(OP_PHI, 0x8a, "\224", "PHI")
+	CNST(OP_PC_phi0, 0x3e, "\224\270", "phi0")
+	CNST(OP_PC_WGS_OMEGA, 0x3f, "\267", "WGS_OMEGA")
+	CNST(OP_NEGINF, 0x40, "-\237", "NEGINF")
+	CNST(OP_INF, 0x41, "\237", "INF")
+	CNST(OP_ZERO, 0x42, "#", "ZERO")
+	CNST(OP_ONE, 0x43, "1", "ONE")
+	CNST(OP_HIGH_RECIP_E, 0x8b, "1/eH", "HIGH_RECIP_E")
+	CNST(OP_LOW_RECIP_E, 0x8c, "1/eL", "LOW_RECIP_E")
+	CNST(OP_RECIP_SQRT5, 0x8d, "1/\0035", "RECIP_SQRT5")
+	CNST(OP_RECIP_SQRTPI, 0x8e, "1/\003\257", "RECIP_SQRTPI")
+	CNST(OP_POINT_2214, 0x44, "Chi2", "POINT_2214")
+	CNST(OP_RECIPLN10, 0x8f, "L10\235", "RECIPLN10")
+	CNST(OP_LN2, 0x90, "LN2", CNULL)
+	CNST(OP_RECIPLN2, 0x91, "LN2\235", "RECIPLN2")
+	CNST(OP_PI, 0x92, "\257", "PI")
+	CNST(OP_PIon2, 0x93, "\257/2", "PIon2")
+	CNST(OP_SQRT_2_PI, 0x94, "\0032\257", "SQRT_2_PI")
+	CNST(OP_INT_R_BOUNDS, 0x45, "\004RgB", "INT_R_BOUNDS")
+#undef CNST
+};
+
+const decimal64 cnsts_d64[] = {
+	B(0x22,0x34,0x00,0x00,0x00,0x00,0x00,0x05),
+	B(0x22,0x28,0x00,0x00,0x00,0x3a,0x31,0xa9),
+	B(0x21,0xe4,0x00,0x0d,0x39,0x5b,0x44,0x43),
+	B(0x22,0x4c,0x00,0x00,0x00,0x00,0x0f,0x4c),
+	B(0x22,0x4c,0x00,0x00,0x00,0x17,0xbf,0xd3),
+	B(0x22,0x38,0x00,0x00,0x12,0xbc,0x61,0xca),
+	B(0x21,0xd8,0x00,0x00,0x17,0x62,0xc4,0xb3),
+	B(0x22,0x10,0x00,0x00,0x08,0xfd,0xb6,0xe0),
+	B(0x21,0xc4,0x00,0x04,0x01,0x5b,0xf8,0xd0),
+	B(0x22,0x24,0x00,0x02,0x68,0x88,0x55,0x21),
+	B(0x22,0x24,0x00,0x00,0x00,0x0f,0x52,0x99),
+	B(0x21,0xf8,0x00,0x00,0x00,0x0a,0x6d,0x98),
+	B(0x22,0x00,0x00,0x01,0xee,0xc1,0x6e,0xdb),
+	B(0xa2,0x00,0xc8,0x39,0xfa,0x26,0xd0,0xb6),
+	B(0x22,0x4c,0x00,0x00,0xfd,0xa0,0x11,0xa2),
+	B(0x21,0x90,0x00,0x00,0x29,0x69,0x7c,0x04),
+	B(0x21,0x94,0x00,0x00,0x00,0xa8,0x86,0xce),
+	B(0x21,0xbc,0x00,0x00,0x08,0xa1,0x03,0x54),
+	B(0x22,0x4c,0x00,0x01,0x34,0x3f,0x4a,0x0d),
+	B(0x21,0x94,0x00,0x00,0x00,0x19,0xa0,0xe5),
+	B(0x21,0x9c,0x00,0x00,0x38,0xee,0xa9,0x64),
+	B(0x22,0x84,0x00,0x00,0x00,0x00,0x1d,0x5d),
+	B(0x21,0xa8,0x00,0x00,0x6a,0x2e,0x7d,0xd7),
+	B(0x21,0xa8,0x00,0x00,0x6a,0x09,0xb7,0x82),
+	B(0x22,0x04,0x00,0x00,0x00,0x03,0x66,0x87),
+	B(0x21,0xac,0x00,0x00,0x0a,0x60,0xd7,0x88),
+	B(0x21,0xec,0x00,0x00,0x5e,0xc6,0x88,0x3e),
+	B(0x21,0xa4,0x00,0x00,0x77,0x38,0x4e,0x52),
+	B(0x22,0xa0,0x00,0x00,0x00,0x00,0x4f,0x7b),
+	B(0x22,0x88,0x00,0x00,0x00,0x00,0xee,0xe0),
+	B(0x22,0x70,0x00,0x01,0x81,0x62,0x33,0x59),
+	B(0x7c,0x00,0x00,0x00,0x00,0x00,0x00,0x00),
+	B(0x22,0x38,0x00,0x00,0x00,0x01,0x95,0x45),
+	B(0x21,0xd8,0x00,0x00,0x00,0x1d,0xae,0x22),
+	B(0x22,0x1c,0x00,0x00,0x05,0x32,0x42,0x56),
+	B(0x21,0xd4,0x00,0x07,0x0b,0x36,0x4c,0xe3),
+	B(0x22,0x1c,0x00,0x40,0x88,0x01,0x2a,0x2b),
+	B(0x22,0x3c,0x00,0x00,0x00,0x02,0xb6,0xf1),
+	B(0x22,0x20,0x0a,0xf3,0x6d,0xb8,0xe1,0xfc),
+	B(0x22,0x50,0x00,0x00,0x00,0x00,0x02,0xb8),
+	B(0x22,0x3c,0x00,0x00,0x00,0x09,0xf4,0x65),
+	B(0x22,0x38,0x00,0x00,0x00,0x65,0xe8,0x89),
+	B(0x22,0x28,0x00,0x0f,0xe3,0x78,0x2c,0x8e),
+	B(0x22,0x00,0x00,0xa7,0x5b,0x5f,0x9c,0x0e),
+	B(0x22,0x00,0x00,0xa8,0x7b,0x5a,0x88,0xe4),
+	B(0x22,0x14,0x00,0x4a,0x90,0x13,0x7e,0x33),
+	B(0x22,0x30,0x00,0x00,0x00,0x00,0x6d,0x3b),
+	B(0x21,0x74,0x00,0x00,0x00,0x08,0x6c,0x74),
+	B(0x22,0xa0,0x00,0x00,0x00,0x16,0x83,0x28),
+	B(0x22,0x14,0x00,0x00,0x01,0x66,0x77,0xc2),
+	B(0x22,0x04,0x00,0x12,0x3c,0xd8,0x36,0x98),
+	B(0x22,0x3c,0x00,0x00,0x01,0xab,0xc0,0xdb),
+	B(0x21,0xe0,0x00,0x06,0x10,0x71,0x99,0x6f),
+	B(0x21,0xd0,0x00,0x20,0xfb,0xf1,0x69,0xe1),
+	B(0x21,0xd0,0x00,0x21,0x08,0xcf,0x65,0x8c),
+	B(0x21,0xb4,0x00,0x02,0x51,0x20,0x27,0xe2),
+	B(0xa1,0xb8,0x00,0x00,0x3a,0x07,0x71,0xce),
+	B(0xa1,0xb4,0x00,0x00,0x00,0x9a,0x59,0x6d),
+	B(0x21,0xa8,0x00,0x03,0x86,0xa1,0x0f,0x69),
+	B(0x21,0xa8,0x00,0x01,0x43,0x2c,0x3e,0xbb),
+	B(0xa1,0xb0,0x00,0x00,0x1c,0x10,0xb3,0x3a),
+	B(0x22,0x00,0x00,0x00,0x00,0x5a,0x79,0x6f),
+	B(0x21,0xd8,0x00,0x00,0x84,0x3d,0x07,0x3f),
+	B(0x22,0x0c,0x00,0x00,0x00,0x74,0x90,0x73),
+	B(0xf8,0x00,0x00,0x00,0x00,0x00,0x00,0x00),
+	B(0x78,0x00,0x00,0x00,0x00,0x00,0x00,0x00),
+	B(0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00),
+	B(0x22,0x38,0x00,0x00,0x00,0x00,0x00,0x01),
+	B(0x22,0x28,0x00,0x00,0x00,0x00,0x08,0xd6),
+	B(0x22,0x2c,0x00,0x00,0x00,0x01,0xe8,0x86),
+};
+
+const decimal128 cnsts_d128[] = {
+	D(0x22,0x07,0xc0,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x05),
+	D(0x22,0x07,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x3a,0x31,0xa9),
+	D(0x29,0xff,0xec,0xe4,0x67,0x3c,0x72,0xc2,0xd3,0xad,0x68,0x47,0xdd,0x75,0x82,0x96),
+	D(0x29,0xff,0xdf,0x6e,0x2f,0x6b,0x17,0xf7,0xcc,0xd9,0x1b,0xe1,0xb6,0x93,0x68,0xd8),
+	D(0x31,0xff,0xe9,0xd3,0x26,0x61,0x19,0xbd,0xea,0x7f,0x55,0x32,0xf3,0x47,0x48,0xca),
+	D(0x6d,0xff,0x89,0xfa,0x3f,0xad,0xc1,0x0b,0xe2,0x5a,0x22,0x08,0xc9,0x55,0x0f,0x49),
+	D(0x2e,0x00,0x6f,0xf4,0xbc,0x86,0x9a,0x6c,0x28,0xaa,0xa9,0xf6,0x00,0x43,0x2c,0xc1),
+	D(0x35,0xff,0xb0,0x42,0x72,0x89,0x03,0xd4,0x89,0x78,0x41,0x1e,0x38,0x4c,0xe0,0x18),
+	D(0x21,0xfd,0x37,0x56,0x8b,0x0d,0xbe,0x82,0x6f,0x64,0x35,0xa4,0x12,0xf2,0xac,0x4b),
+	D(0x25,0xfe,0x50,0x09,0xf4,0x3d,0x6c,0xf9,0x54,0x9d,0x81,0x0e,0x56,0x14,0xdf,0x21),
+	D(0x25,0xff,0xe6,0xa0,0x87,0xdc,0xbb,0x77,0xed,0x40,0xcc,0x92,0xb4,0x25,0xb6,0x7e),
+	D(0x22,0x00,0x02,0x4c,0x4f,0xb0,0x1d,0x49,0x03,0xa0,0x9f,0x8a,0x17,0x90,0x40,0x92),
+	D(0x69,0xf7,0x6a,0x27,0x28,0x6f,0x4d,0x93,0xda,0x99,0x59,0x13,0x97,0x00,0x43,0xcf),
+	D(0x31,0xff,0x9d,0x82,0x1f,0xba,0xf9,0xe4,0x36,0x23,0x32,0x56,0xd5,0x17,0x3a,0x28),
+	D(0x35,0xff,0xa8,0x1d,0xff,0x43,0x77,0x63,0x2d,0x95,0xe0,0xc6,0xa0,0x39,0x7e,0xd6),
+	D(0x31,0xff,0x95,0x6e,0xc3,0x33,0x08,0x20,0x64,0x51,0xff,0x48,0x4b,0xd2,0x98,0x33),
+	D(0x39,0xff,0xba,0x37,0x5f,0x25,0x95,0xdc,0x51,0x78,0xac,0x50,0x4d,0x69,0x16,0xfe),
+	D(0x25,0xff,0xdb,0xaa,0xdc,0x28,0xde,0x3c,0x36,0x5d,0x67,0xe7,0x2a,0x90,0x07,0x7c),
+	D(0x2d,0xff,0xc8,0xd9,0x42,0x8d,0x93,0x71,0x93,0xb9,0xce,0xa0,0xd7,0xf4,0x5d,0xf7),
+	D(0x25,0xff,0xe3,0xac,0x71,0x46,0xc6,0xb8,0x09,0xac,0xe7,0x50,0x6b,0x39,0xfe,0xef),
+	D(0x29,0xff,0xdf,0xa9,0xd1,0x12,0x9d,0xc0,0x07,0xd9,0x9f,0xbf,0x51,0xcc,0xac,0x2d),
+};
+
+/* Table of metric/imperial conversion constants
+ */
+const struct cnsts_conv cnsts_conv[] = {
+#define CNST(n, b1,b2,b3,b4,b5,b6,b7,b8, fm, fi) { B(b1,b2,b3,b4,b5,b6,b7,b8), fm, fi },
+	CNST(OP_KG_LBM, 0x22, 0x18, 0x00, 0x00, 0x02, 0xd5, 0x9c, 0xed, "kg", "lb")
+	CNST(OP_KG_STONE, 0x22, 0x18, 0x00, 0x00, 0x27, 0xb0, 0x75, 0x3e, "kg", "stone")
+	CNST(OP_KG_CWT, 0x22, 0x18, 0x00, 0x01, 0x45, 0x03, 0xaa, 0x20, "kg", "cwt")
+	CNST(OP_KG_SHCWT, 0x22, 0x20, 0x00, 0x00, 0x02, 0xd5, 0x9c, 0xed, "kg", "s.cwt")
+	CNST(OP_G_OZ, 0x22, 0x14, 0x00, 0x07, 0x15, 0xd8, 0x2c, 0x7d, "g", "oz")
+	CNST(OP_G_TOZ, 0x22, 0x1c, 0x00, 0x00, 0x13, 0x70, 0x8b, 0x00, "g", "tr.oz")
+	CNST(OP_L_GALUK, 0x22, 0x24, 0x00, 0x00, 0x00, 0x07, 0x1a, 0x61, "l", "galUK")
+	CNST(OP_L_GALUS, 0x22, 0x14, 0x00, 0x00, 0xf1, 0x16, 0x6f, 0x10, "l", "galUS")
+	CNST(OP_L_CUBFT, 0x22, 0x14, 0x00, 0x07, 0x13, 0xcd, 0x3a, 0x50, "l", "cft")
+	CNST(OP_ML_FLOZUK, 0x22, 0x1c, 0x00, 0x00, 0x11, 0xc2, 0x0a, 0x71, "ml", "flozUK")
+	CNST(OP_ML_FLOZUS, 0x22, 0x10, 0x00, 0x49, 0xed, 0xf4, 0x9e, 0x71, "ml", "flozUS")
+	CNST(OP_CM_INCH, 0x22, 0x30, 0x00, 0x00, 0x00, 0x00, 0x00, 0xfe, "cm", "inches")
+	CNST(OP_M_FATHOM, 0x22, 0x28, 0x00, 0x00, 0x00, 0x00, 0x49, 0x20, "m", "fathom")
+	CNST(OP_M_FEET, 0x22, 0x28, 0x00, 0x00, 0x00, 0x00, 0x0c, 0x30, "m", "feet")
+	CNST(OP_M_FEETUS, 0x2d, 0xf8, 0x30, 0x01, 0x86, 0x00, 0x30, 0xc0, "m", "feetUS")
+	CNST(OP_M_YARD, 0x22, 0x28, 0x00, 0x00, 0x00, 0x00, 0x24, 0x90, "m", "yards")
+	CNST(OP_KM_MILE, 0x22, 0x20, 0x00, 0x00, 0x00, 0x19, 0x85, 0x58, "km", "miles")
+	CNST(OP_KM_LY, 0x22, 0x34, 0x5e, 0x97, 0xd3, 0x0b, 0x57, 0x28, "km", "l.y.")
+	CNST(OP_KM_PC, 0x2e, 0x30, 0x55, 0xa9, 0x64, 0x57, 0xad, 0x6f, "km", "pc")
+	CNST(OP_KM_AU, 0x22, 0x34, 0x00, 0x00, 0x5e, 0xff, 0x4a, 0xc3, "km", "AU")
+	CNST(OP_KM_NMI, 0x22, 0x2c, 0x00, 0x00, 0x00, 0x00, 0x07, 0x54, "km", "nmi")
+	CNST(OP_HA_ACREUK, 0x22, 0x0c, 0x00, 0x0a, 0x1d, 0x48, 0xd0, 0xe0, "ha", "acres")
+	CNST(OP_HA_ACREUS, 0x31, 0xf8, 0x2e, 0xda, 0x26, 0x1d, 0xa8, 0xfc, "ha", "acreUS")
+	CNST(OP_N_LBF, 0x22, 0x04, 0x2c, 0x78, 0x8d, 0x82, 0x62, 0x5d, "N", "lbf")
+	CNST(OP_J_BTU, 0x22, 0x18, 0x00, 0x1a, 0x5f, 0x99, 0x25, 0x06, "J", "Btu")
+	CNST(OP_J_CAL, 0x22, 0x28, 0x00, 0x00, 0x00, 0x00, 0xa7, 0x64, "J", "cal")
+	CNST(OP_J_kWh, 0x22, 0x38, 0x00, 0x00, 0x00, 0x39, 0x60, 0x00, "J", "kWh")
+	CNST(OP_Pa_ATM, 0x22, 0x38, 0x00, 0x00, 0x00, 0x01, 0x95, 0x45, "Pa", "atm")
+	CNST(OP_Pa_bar, 0x22, 0x38, 0x00, 0x00, 0x00, 0x01, 0x90, 0x00, "Pa", "bar")
+	CNST(OP_Pa_mmHg, 0x22, 0x14, 0x00, 0x21, 0x54, 0x26, 0x0d, 0x9f, "Pa", "mmHg")
+	CNST(OP_Pa_psi, 0x3a, 0x0b, 0x7e, 0xbd, 0x52, 0x52, 0xa1, 0x69, "Pa", "psi")
+	CNST(OP_Pa_inhg, 0x22, 0x14, 0x03, 0x60, 0x98, 0x4a, 0x01, 0x55, "Pa", "inHg")
+	CNST(OP_Pa_torr, 0x26, 0x05, 0x4d, 0x37, 0xea, 0xc3, 0x4a, 0x0e, "Pa", "torr")
+	CNST(OP_W_HP550, 0x3e, 0x05, 0xc8, 0xf9, 0xac, 0xbc, 0xda, 0xbe, "W", "hp(I)")
+	CNST(OP_W_HP, 0x22, 0x24, 0x00, 0x00, 0x04, 0x98, 0x97, 0x6b, "W", "hp(M)")
+	CNST(OP_W_HPe, 0x22, 0x38, 0x00, 0x00, 0x00, 0x00, 0x02, 0xea, "W", "hp(E)")
+	CNST(OP_T_TON, 0x22, 0x10, 0x00, 0x02, 0x8a, 0x07, 0x54, 0x58, "t", "tons")
+	CNST(OP_T_SHTON, 0x22, 0x18, 0x00, 0x00, 0x05, 0xab, 0x39, 0xda, "t", "s.tons")
+#undef CNST
+};
+
+
+#undef B
+#undef D
+
@@ -211,7 +211,7 @@ typedef struct _ram {
 
 } TPersistentRam;
 
-extern TPersistentRam PersistentRam;
+extern INSTANCE TPersistentRam PersistentRam;
 
 #define State		(PersistentRam._state)
 #define UState		(PersistentRam._ustate)
@@ -333,7 +333,7 @@ typedef struct _while_on {
 #endif	
 } TStateWhileOn;
 
-extern TStateWhileOn StateWhileOn;
+extern INSTANCE TStateWhileOn StateWhileOn;
 
 #define State2		 (StateWhileOn._state2)
 #define TestFlag	 (State2.test_flag)
@@ -396,7 +396,7 @@ typedef struct _xrom_params
 	signed short int user_ret_stk_ptr;      // ... the user stack pointer
 } TXromParams;
 
-extern TXromParams XromParams;
+extern INSTANCE TXromParams XromParams;
 
 #define XROM_SYSTEM_FLAG_BASE (8)
 
@@ -412,7 +412,7 @@ extern TXromParams XromParams;
 
 /* Private memory for storing registers A-D
  */
-extern REGISTER XromA2D[4];
+extern INSTANCE REGISTER XromA2D[4];
 
 
 /*
@@ -430,7 +430,7 @@ typedef struct _xrom_local
 
 } TXromLocal;
 
-extern TXromLocal XromLocal;
+extern INSTANCE TXromLocal XromLocal;
 
 #define XromStack  (XromLocal._stack)
 #define XromRetStk (XromLocal._ret_stk + XROM_RET_STACK_SIZE)
@@ -469,41 +469,42 @@ extern FLAG Xtal;
 
 extern volatile FLAG WaitForLcd;     // Sync with display refresh
 extern FLAG DebugFlag;		     // Set in Main
-extern volatile unsigned char Pause; // Count down for programmed pause
-extern FLAG Running, XromRunning;    // Program is active
+extern INSTANCE volatile unsigned char Pause; // Count down for programmed pause
+extern INSTANCE FLAG Running, XromRunning;    // Program is active
 extern FLAG JustStopped;             // Set on program stop to ignore the next R/S key in the buffer
-extern SMALL_INT Error;	     	     // Did an error occur, if so what code?
-extern SMALL_INT ShowRegister;       // Temporary display (not X)
-extern FLAG PcWrapped;		     // decpc() or incpc() have wrapped around
-extern FLAG ShowRPN;		     // controls the RPN annunciator
-extern FLAG IoAnnunciator;	     // Indicates I/O in progress (higher power consumption)
-extern SMALL_INT IntMaxWindow;       // Number of windows for integer display
-extern const char *DispMsg;	     // What to display in message area
-extern short int DispPlot;	     // Which register to base graphical display from
-extern unsigned int OpCode;          // Pending execution waiting for key-release
-extern s_opcode XeqOpCode;	     // Currently executed function
-extern FLAG GoFast;	 	     // Speed-up might be necessary
-extern unsigned short *RetStk;	     // Pointer to current top of return stack
-extern SMALL_INT RetStkSize;         // actual size of return stack
-extern SMALL_INT ProgFree;	     // Remaining program steps
-extern SMALL_INT SizeStatRegs;       // Size of summation register block
-extern REGISTER *StackBase;	     // Location of the RPN stack
-extern decContext Ctx;		     // decNumber library context
-extern FLAG JustDisplayed;	     // Avoid duplicate calls to display();
-extern FLAG WasDataEntry;	     // No need to update the display
-extern char TraceBuffer[];           // Display current instruction
+extern INSTANCE SMALL_INT Error;	     	     // Did an error occur, if so what code?
+extern INSTANCE SMALL_INT ShowRegister;       // Temporary display (not X)
+extern INSTANCE FLAG PcWrapped;		     // decpc() or incpc() have wrapped around
+extern INSTANCE FLAG ShowRPN;		     // controls the RPN annunciator
+extern INSTANCE FLAG IoAnnunciator;	     // Indicates I/O in progress (higher power consumption)
+extern INSTANCE SMALL_INT IntMaxWindow;       // Number of windows for integer display
+extern INSTANCE const char *DispMsg;	     // What to display in message area
+extern INSTANCE short int DispPlot;	     // Which register to base graphical display from
+extern INSTANCE unsigned int OpCode;          // Pending execution waiting for key-release
+extern INSTANCE s_opcode XeqOpCode;	     // Currently executed function
+extern INSTANCE FLAG GoFast;	 	     // Speed-up might be necessary
+extern INSTANCE unsigned short *RetStk;	     // Pointer to current top of return stack
+extern INSTANCE SMALL_INT RetStkSize;         // actual size of return stack
+extern INSTANCE SMALL_INT ProgFree;	     // Remaining program steps
+extern INSTANCE SMALL_INT SizeStatRegs;       // Size of summation register block
+extern INSTANCE REGISTER *StackBase;	     // Location of the RPN stack
+extern INSTANCE decContext Ctx;		     // decNumber library context
+extern INSTANCE FLAG JustDisplayed;	     // Avoid duplicate calls to display();
+extern INSTANCE FLAG WasDataEntry;	     // No need to update the display
+extern INSTANCE char TraceBuffer[];           // Display current instruction
 #ifndef REALBUILD
-extern char LastDisplayedText[NUMALPHA + 1];	   // This is for the emulator (clipboard)
-extern char LastDisplayedNumber[NUMBER_LENGTH+1]; // Used to display with fonts in emulators
-extern char LastDisplayedExponent[EXPONENT_LENGTH+1]; // Used to display with fonts in emulators
+extern INSTANCE char LastDisplayedText[NUMALPHA + 1];	   // This is for the emulator (clipboard)
+extern INSTANCE char LastDisplayedNumber[NUMBER_LENGTH+1]; // Used to display with fonts in emulators
+extern INSTANCE char LastDisplayedExponent[EXPONENT_LENGTH+1]; // Used to display with fonts in emulators
 #endif
 extern FLAG Tracing;		     // Set by SF T for INFRARED builds
 #ifdef CONSOLE
-extern unsigned long long int instruction_count;
-extern int view_instruction_counter;
+extern INSTANCE unsigned long long int instruction_count;
+extern INSTANCE int view_instruction_counter;
+extern INSTANCE int last_error;		     // Last error reported by xeq()
 #endif
 #ifdef RP_PREFIX
-extern SMALL_INT RectPolConv; // 1 - R->P just done; 2 - P->R just done
+extern INSTANCE SMALL_INT RectPolConv; // 1 - R->P just done; 2 - P->R just done
 #endif
 #if INTERRUPT_XROM_TICKS > 0
 extern volatile unsigned int OnKeyTicks; // ON (EXIT) key has been held down for this many ticks
@@ -43,9 +43,12 @@
   // Define the decNumber data structure.  The size and shape of the
   // units array in the structure is determined by the following
   // constant.  This must not be changed without recompiling the
-  // decNumber library modules.
-  #define DECDPUN 3                // DECimal Digits Per UNit [must be in
+  // decNumber library modules.  The emulators override it from the
+  // Makefile, the firmware uses 3.
+  #if !defined(DECDPUN)
+    #define DECDPUN 3              // DECimal Digits Per UNit [must be in
                                    // range 1-9; 3 or powers of 2 are best].
+  #endif
 
   // DECNUMDIGITS is the default number of digits that can be held in
   // the structure.  If undefined, 1 is assumed and it is assumed that
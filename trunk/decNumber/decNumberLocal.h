@@ -35,7 +35,9 @@
 
   /* Conditional code flags -- set these to 1 for best performance */
   #define DECENDIAN 1         // 1=concrete formats are endian
+  #if !defined(DECUSE64)
   #define DECUSE64  0         // 1 to allow use of 64-bit integers
+  #endif
 
   /* Conditional check flags -- set these to 0 for best performance */
   #define DECCHECK  0         // 1 to enable robust checking
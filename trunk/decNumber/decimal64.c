@@ -649,7 +649,13 @@ void decDigitsFromDPD(decNumber *dn, const uInt *sour, Int declets) {
       continue;
       }
 
+#if 0
     bcd=DPD2BCD[dpd];              // convert 10 bits to 12 bits BCD
+#else
+    if (dpd >= 1000)
+	    dpd = 0;
+    bcd = ((dpd / 100) << 8) | ((dpd / 10 % 10) << 4) | (dpd % 10);
+#endif
 
     // now accumulate the 3 BCD nibbles into units
     nibble=bcd & 0x00f;
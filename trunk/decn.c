@@ -1599,6 +1599,137 @@ decNumber *decNumberArcTanh(decNumber *res, const decNumber *x) {
 }
 
 
+/* The abscissa and weight of one node of the double exponential integrator
+ * in xrom/integrate.wp34s.  X holds t and Y the kind of node: 0 tanh-sinh,
+ * 1 exp-sinh or 2 sinh-sinh.  Returns the normalised abscissa in X, its
+ * weight in Y and cosh(t) in Z.
+ *
+ * Every intermediate is rounded to a register as the keystrokes this replaces
+ * did so the integrator's results don't change.  The emulators also remember
+ * the nodes on the t = j / 128 grid the integrator uses.
+ */
+#define DEI_TANHSINH	0
+#define DEI_EXPSINH	1
+#define DEI_SINHSINH	2
+
+#ifdef DEI_NODE_CACHE
+#define DEI_NODE_GRID	128			// nodes per unit of t
+#define DEI_NODE_MAX	(10 * DEI_NODE_GRID)	// enough for t up to 10
+
+static INSTANCE struct _dei_node {
+	unsigned char valid;
+	REGISTER r, w, ch;
+} DeiNodes[2][3][DEI_NODE_MAX];
+
+static void dei_pack(REGISTER *r, const decNumber *x, int dbl) {
+	if (dbl)
+		packed128_from_number(&(r->d), x);
+	else
+		packed_from_number(&(r->s), x);
+}
+
+static void dei_unpack(decNumber *x, const REGISTER *r, int dbl) {
+	if (dbl)
+		decimal128ToNumber(&(r->d), x);
+	else
+		decimal64ToNumber(&(r->s), x);
+}
+#endif
+
+static decNumber *dei_round(decNumber *x) {
+	decNumber t;
+
+	decNumberNormalize(&t, x, &Ctx);
+	if (is_dblmode()) {
+		decimal128 d;
+
+		packed128_from_number(&d, &t);
+		decimal128ToNumber(&d, x);
+	} else {
+		decimal64 s;
+
+		packed_from_number(&s, &t);
+		decimal64ToNumber(&s, x);
+	}
+	return x;
+}
+
+static void dei_node(decNumber *r, decNumber *w, decNumber *ch, const decNumber *t, int kind) {
+	decNumber e, u, v;
+	const int dbl = is_dblmode();
+
+	dei_round(decNumberCosh(ch, t));
+	dei_round(decNumberSquare(&u, ch));
+	dei_round(dn_dec(&u));
+	dei_round(dn_sqrt(&v, &u));
+	get_const_number(&u, OP_PIon2, dbl);
+	dei_round(dn_multiply(&e, &v, &u));
+	if (kind == DEI_EXPSINH)
+		dei_round(dn_exp(&u, &e));
+	else
+		dei_round(decNumberCosh(&u, &e));
+
+	if (kind == DEI_TANHSINH) {
+		dei_round(decNumberSquare(&v, &u));
+		dei_round(decNumberRecip(w, &v));
+	} else
+		decNumberCopy(w, &u);
+
+	if (kind == DEI_EXPSINH)
+		decNumberCopy(r, &u);
+	else {
+		dei_round(decNumberSquare(&v, &u));
+		dei_round(dn_dec(&v));
+		dei_round(dn_sqrt(r, &v));
+		if (kind == DEI_TANHSINH)
+			dei_round(dn_divide(r, r, &u));
+	}
+}
+
+void op_dei_node(enum nilop op) {
+	decNumber t, k, r, w, ch;
+	int kind;
+#ifdef DEI_NODE_CACHE
+	struct _dei_node *node = NULL;
+	decNumber n;
+	const int dbl = is_dblmode();
+#endif
+
+	getXY(&t, &k);
+	kind = dn_to_int(&k);
+	if (kind < DEI_TANHSINH || kind > DEI_SINHSINH) {
+		report_err(ERR_BAD_PARAM);
+		return;
+	}
+#ifdef DEI_NODE_CACHE
+	int_to_dn(&k, DEI_NODE_GRID);
+	dn_multiply(&n, &t, &k);
+	if (is_int(&n) && ! dn_lt0(&n)) {
+		const int i = dn_to_int(&n);
+
+		if (i < DEI_NODE_MAX)
+			node = &DeiNodes[dbl][kind][i];
+	}
+	if (node != NULL && node->valid) {
+		dei_unpack(&r, &node->r, dbl);
+		dei_unpack(&w, &node->w, dbl);
+		dei_unpack(&ch, &node->ch, dbl);
+	} else {
+		dei_node(&r, &w, &ch, &t, kind);
+		if (node != NULL) {
+			dei_pack(&node->r, &r, dbl);
+			dei_pack(&node->w, &w, dbl);
+			dei_pack(&node->ch, &ch, dbl);
+			node->valid = 1;
+		}
+	}
+#else
+	dei_node(&r, &w, &ch, &t, kind);
+#endif
+	setXY(&r, &w);
+	setRegister(regZ_idx, &ch);
+}
+
 decNumber *decNumberD2R(decNumber *res, const decNumber *x) {
 	return dn_multiply(res, x, &const_PIon180);
 }
@@ -2326,23 +2457,21 @@ static decNumber *gcf(decNumber *res, const decNumber *a, const decNumber *x, co
 	return dn_multiply(res, &t, &h);
 }
 
-decNumber *decNumberGammap(decNumber *res, const decNumber *x, const decNumber *a) {
+/* The incomplete gamma functions, lower or upper and optionally regularised.
+ */
+decNumber *dn_gammainc(decNumber *res, const decNumber *x, const decNumber *a, int regularised, int upper) {
 	decNumber z, lga;
-	const int op = XeqOpCode - (OP_DYA | OP_GAMMAg);
-	const int regularised = op & 2;
-	const int upper = op & 1;
 
 	if (decNumberIsNegative(x) || dn_le0(a) ||
 			decNumberIsNaN(x) || decNumberIsNaN(a) || decNumberIsInfinite(a)) {
 		return set_NaN(res);
 	}
 	if (decNumberIsInfinite(x)) {
-		if (upper) {
-			if (regularised)
-				return dn_1(res);
-			return decNumberGamma(res, a);
-		}
-		return decNumberZero(res);
+		if (upper)
+			return decNumberZero(res);
+		if (regularised)
+			return dn_1(res);
+		return decNumberGamma(res, a);
 	}
 
 	dn_p1(&lga, a);
@@ -2371,6 +2500,12 @@ invert:	if (regularised)
 	return dn_subtract(res, &z, res);
 }
 
+decNumber *decNumberGammap(decNumber *res, const decNumber *x, const decNumber *a) {
+	const int op = XeqOpCode - (OP_DYA | OP_GAMMAg);
+
+	return dn_gammainc(res, x, a, op & 2, op & 1);
+}
+
 #ifdef INCLUDE_FACTOR
 decNumber *decFactor(decNumber *r, const decNumber *x) {
 	int sgn;
@@ -126,6 +126,7 @@ extern decNumber *do_atan2(decNumber *at, const decNumber *ain, const decNumber
 
 extern void op_r2p(enum nilop op);
 extern void op_p2r(enum nilop op);
+extern void op_dei_node(enum nilop op);
 
 extern decNumber *decNumberSinh(decNumber *res, const decNumber *x);
 extern decNumber *decNumberCosh(decNumber *res, const decNumber *x);
@@ -147,6 +148,7 @@ extern decNumber *decNumberLnBeta(decNumber *res, const decNumber *x, const decN
 extern decNumber *decNumberERF(decNumber *res, const decNumber *x);
 extern decNumber *decNumberERFC(decNumber *res, const decNumber *x);
 extern decNumber *decNumberGammap(decNumber *res, const decNumber *a, const decNumber *x);
+extern decNumber *dn_gammainc(decNumber *res, const decNumber *x, const decNumber *a, int regularised, int upper);
 
 extern decNumber *decNumberD2G(decNumber *res, const decNumber *x);
 extern decNumber *decNumberD2R(decNumber *res, const decNumber *x);
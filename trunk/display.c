@@ -28,8 +28,8 @@
 #include "printer.h"
 #include "serial.h"
 
-static enum separator_modes { SEP_NONE, SEP_COMMA, SEP_DOT } SeparatorMode;
-static enum decimal_modes { DECIMAL_DOT, DECIMAL_COMMA } DecimalMode;
+static INSTANCE enum separator_modes { SEP_NONE, SEP_COMMA, SEP_DOT } SeparatorMode;
+static INSTANCE enum decimal_modes { DECIMAL_DOT, DECIMAL_COMMA } DecimalMode;
 
 static void set_status_sized(const char *, int);
 static void set_status(const char *);
@@ -39,19 +39,19 @@ static void set_status_graphic(const unsigned char *);
 static void set_int_x(const long long int value, char *res);
 #endif
 
-const char *DispMsg;	   // What to display in message area
-short int DispPlot;
+INSTANCE const char *DispMsg;	   // What to display in message area
+INSTANCE short int DispPlot;
 #ifndef REALBUILD
-char LastDisplayedText[NUMALPHA + 1];	   // For clipboard export
-char LastDisplayedNumber[NUMBER_LENGTH + 1];
-char LastDisplayedExponent[EXPONENT_LENGTH + 1];
-char forceDispPlot;
+INSTANCE char LastDisplayedText[NUMALPHA + 1];	   // For clipboard export
+INSTANCE char LastDisplayedNumber[NUMBER_LENGTH + 1];
+INSTANCE char LastDisplayedExponent[EXPONENT_LENGTH + 1];
+INSTANCE char forceDispPlot;
 #endif
 
-FLAG ShowRPN;		   // controls visibility of RPN annunciator
-FLAG JustDisplayed;	   // Avoid duplicate calls to display()
-SMALL_INT IntMaxWindow;    // Number of windows for integer display
-FLAG IoAnnunciator;	   // Status of the little "=" sign
+INSTANCE FLAG ShowRPN;		   // controls visibility of RPN annunciator
+INSTANCE FLAG JustDisplayed;	   // Avoid duplicate calls to display()
+INSTANCE SMALL_INT IntMaxWindow;    // Number of windows for integer display
+INSTANCE FLAG IoAnnunciator;	   // Status of the little "=" sign
 
 /* Message strings
  * Strings starting S7_ are for the lower 7 segment line.  Strings starting S_
@@ -80,6 +80,87 @@
 // Code to allow access to caller's local data from xIN-code
 // #define ENABLE_COPYLOCALS
 
+// Keep a sorted index of the labels in each program region so that GTO,
+// XEQ and LBL? don't have to scan the program step by step.
+// Needs heap memory, so it's for the emulators only.
+#ifndef REALBUILD
+#define LABEL_INDEX
+#endif
+
+// Instead of copying the whole stack before every instruction, save the
+// stack registers an instruction overwrites as it goes (copy on write).
+// Only the function table commands and a few register and branch commands
+// take this path, everything else still takes the full snapshot.
+#ifndef REALBUILD
+#define UNDO_JOURNAL
+#endif
+
+// Keep unpacked copies of recently read registers so that programs working
+// on the stack don't decode the same DPD value again on every access.
+// Costs about 2KB of RAM, so it's for the emulators only.
+#ifndef REALBUILD
+#define REGISTER_CACHE
+#endif
+
+// Keep the LU decomposition of the last square matrix factored so that
+// M.DET, M-1, LINEQS and M.LU on an unchanged matrix don't factor it again.
+// Costs about 2.5KB of RAM, so it's for the emulators only.
+#ifndef REALBUILD
+#define LU_CACHE
+#endif
+
+// Remember the abscissae and weights of the double exponential integrator
+// so that repeated integrations only spend their time in the integrand.
+// Costs about 370KB of RAM, so it's for the emulators only.
+#ifndef REALBUILD
+#define DEI_NODE_CACHE
+#endif
+
+// Keep the constants converted to the other precision and unpacked once
+// they have been used, so that pushing a constant in double precision,
+// a unit conversion or the integrator don't decode them again every time.
+// Costs about 11KB of RAM, so it's for the emulators only.
+#ifndef REALBUILD
+#define CONST_CACHE
+#endif
+
+// Load statistical data in bulk (calc batch -d) with the sums kept
+// unpacked and compensated until the end instead of one sigma+ at a time.
+#ifndef REALBUILD
+#define SIGMA_BULK
+#endif
+
+// Fill a matrix with uniform, normal or exponential random numbers (M.RAN)
+// and give every batch job a random number stream of its own (calc batch -r)
+// by jumping the generator ahead.
+#ifndef REALBUILD
+#define BULK_RANDOM
+#endif
+
+// Compute the CDFs, upper tail CDFs and quantiles of the normal, log normal,
+// chi-squared, t, F, binomial and Poisson distributions in C instead of
+// XROM, "make distcheck" compares them with the calculator's.  Double
+// precision results can differ in the last digit or two.
+// Opt-in with "make NATIVE_DISTRIBUTIONS=1", emulators only.
+#if defined(NATIVE_DISTRIBUTIONS) && defined(REALBUILD)
+#undef NATIVE_DISTRIBUTIONS
+#endif
+
+// Make all calculator state thread local so that a process can run several
+// independent calculators side by side, one per thread.  The console
+// emulator uses it for parallel batch jobs (calc batch -j).
+// Opt-in with "make MULTI_INSTANCE=1", console emulator only.
+#if defined(MULTI_INSTANCE) && !defined(CONSOLE)
+#undef MULTI_INSTANCE
+#endif
+
+// Time every program step and the decNumber calls it makes, by opcode,
+// by program step and by routine along the return stack (calc batch -P).
+// Opt-in with "make PROFILER=1", console emulator only.
+#if defined(PROFILER) && (!defined(CONSOLE) || defined(MULTI_INSTANCE))
+#undef PROFILER
+#endif
+
 #ifndef TINY_BUILD
 
 // Include the Mantissa and exponent function
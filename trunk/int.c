@@ -1391,16 +1391,32 @@ long long int intFib(long long int x) {
 }
 
 
+#ifndef __SIZEOF_INT128__
+/* Calculate (a + b) mod c for a, b < c without overflow */
+static unsigned long long int addmod(const unsigned long long int a, const unsigned long long int b, const unsigned long long int c) {
+	return a >= c - b ? a - (c - b) : a + b;
+}
+#endif
+
 /* Calculate (a . b) mod c taking care to avoid overflow */
 static unsigned long long mulmod(const unsigned long long int a, unsigned long long int b, const unsigned long long int c) {
+#ifdef __SIZEOF_INT128__
+	// The compiler has a double width multiply and divide
+	return (unsigned long long int) (((unsigned __int128) a * b) % c);
+#else
 	unsigned long long int x=0, y=a%c;
+
+	if ((a | b) < 0x100000000ull)
+		return (a * b) % c;
+	b %= c;
 	while (b > 0) {
 		if ((b & 1))
-			x = (x+y)%c;
-		y = (y+y)%c;
+			x = addmod(x, y, c);
+		y = addmod(y, y, c);
 		b /= 2;
 	}
-	return x % c;
+	return x;
+#endif
 }
 
 /* Calculate (a ^ b) mod c */
@@ -1429,16 +1445,11 @@ int isPrime(unsigned long long int p) {
 #ifndef TINY_BUILD
 	int i;
 	unsigned long long int s;
-#define PRIME_ITERATION	15
+/* The first twelve primes as bases are a proof for all p < 3.3e24 */
+#define PRIME_ITERATION	12
 
 	if (p < 2)	return 0;
 
-	/* We fail for numbers >= 2^63 */
-	if ((p & 0x8000000000000000ull) != 0) {
-		report_err(ERR_DOMAIN);
-		return 1;
-	}
-
 	/* Quick check for divisibility by small primes */
 	for (i=0; i<N_PRIMES; i++)
 		if (p == primes[i])
@@ -1474,8 +1485,10 @@ long long int intmodop(long long int z, long long int y, long long int x) {
 	unsigned long long int vz = extract_value(z, &sz);
 	unsigned long long int r;
 
-	if (sx || sy || sz || vx <= 1)
+	if (sx || sy || sz || vx <= 1) {
 		report_err(ERR_DOMAIN);
+		return 0;
+	}
 	if (XeqOpCode == (OP_TRI | OP_MULMOD))
 		r = mulmod(vz, vy, vx);
 	else
@@ -1525,26 +1538,80 @@ static int dscanOdd(unsigned int d, unsigned int limit, int nd, unsigned int ad[
 	}
 	return d;
 }
+
+/* One step of the pseudo random sequence y^2 + c mod n
+ */
+static unsigned long long int rho_step(unsigned long long int y, unsigned long long int c, unsigned long long int n)
+{
+	y = mulmod(y, y, n);
+	return y >= n - c ? y - (n - c) : y + c;
+}
+
+/* Pollard's rho with Brent's cycle detection.
+ * Returns a non trivial factor of the odd composite `n' or `n' if the
+ * sequence for this `c' cycled without finding one.
+ */
+static unsigned long long int pollard_brent(unsigned long long int n, unsigned long long int c)
+{
+	// gcd is taken every RHO_BATCH steps on the product of the differences
+#define RHO_BATCH	64
+	unsigned long long int x, y = 2, ys = 2, q = 1, g = 1;
+	unsigned long long int r = 1, k, i;
+
+	do {
+		x = y;
+		for (i = 0; i < r; i++)
+			y = rho_step(y, c, n);
+		for (k = 0; k < r && g == 1; k += RHO_BATCH) {
+			ys = y;
+			for (i = 0; i < RHO_BATCH && i < r - k; i++) {
+				y = rho_step(y, c, n);
+				q = mulmod(q, x > y ? x - y : y - x, n);
+			}
+			g = int_gcd(q, n);
+		}
+		r *= 2;
+	} while (g == 1);
+
+	if (g == n) {
+		// The batch overshot, step through it one by one
+		do {
+			ys = rho_step(ys, c, n);
+			g = int_gcd(x > ys ? x - ys : ys - x, n);
+		} while (g == 1);
+	}
+	return g;
+#undef RHO_BATCH
+}
+
+/* Least prime factor of `n' which has no factors below the trial limit
+ */
+static unsigned long long int rho_factor(unsigned long long int n)
+{
+	unsigned long long int c, d, e;
+
+	if (isPrime(n))
+		return n;
+	for (c = 1; (d = pollard_brent(n, c)) == n; c++)
+		busy();
+	d = rho_factor(d);
+	e = rho_factor(n / d);
+	return d < e ? d : e;
+}
 #endif
 
 unsigned long long int doFactor(unsigned long long int n)
 {
 #ifndef TINY_BUILD
 	/* find the least prime factor of `n'.
-	* numbers up to 10^14 can be factored. worst case about 30 seconds
-	* on realbuild.
+	* trial division finds factors up to dmax, anything left over
+	* is split by Pollard's rho until only primes remain.
 	*
 	* returns least prime factor or `n' if prime.
-	* returns 0 if failed to find factor.
-	*
-	* we will only fail if we have a 14 digit number with a factor > dmax (1e7).
-	* since we have a 12 digit display, this ought to be good, but actually more digits are
-	* held internally. for example 10000019*1000079 displays as scientific, but actually all
-	* the digits are held. this example will return 0.
 	*/
 
 	unsigned int d;
-	unsigned int dmax = 10000000; // biggest factor, 10^7
+	unsigned int dmax = 65536; // biggest factor for trial division
 	unsigned int rt;
 	unsigned int limit;
 
@@ -1560,13 +1627,18 @@ unsigned long long int doFactor(unsigned long long int n)
 		if (n % primes[i] == 0)
 			return primes[i];
 	}
-	if (n <= QUICK_CHECK)		// the number is prime
-		return n;
+	for (d = 59; d < 257; d += 2) {
+		if ((unsigned long long int) d * d > n)
+			return n;	// the number is prime
+		if (n % d == 0)
+			return d;
+	}
 
-	rt = (unsigned int)intSqrt(n);
+	// no need to look beyond the square root
+	rt = dmax;
+	while ((unsigned long long int) rt * rt > n)
+		rt = (rt + n / rt) / 2;
 	limit = rt;
-	if (limit > dmax)
-		limit = dmax; // max time about 30 seconds
 
 	// starting factor for search
 	d = 257;
@@ -1577,18 +1649,20 @@ unsigned long long int doFactor(unsigned long long int n)
 	cp = (unsigned char*)&n;
 	nd = 0;
 	for (i = 0; i < sizeof(n); ++i)
-		if ((ad[i] = *cp++) != 0) ++nd;
+		if ((ad[i] = *cp++) != 0) nd = i + 1;
 
 	// and slide to 257
 	for (i = nd-2; i >= 0; --i)
 	{
 		for (j = i; j < nd-1; ++j)
 		{
-			if ((ad[j] -= ad[j+1]) < 0)
+			int v = ad[j] - ad[j+1];
+			if (v < 0)
 			{
-				ad[j] += d;
+				v += d;
 				--ad[j+1];
 			}
+			ad[j] = v;
 		}
 		if (!ad[j]) --nd;
 	}
@@ -1599,10 +1673,10 @@ unsigned long long int doFactor(unsigned long long int n)
 		d = dscanOdd(d, limit, nd, ad);
 		if (!d)
 		{
-			// no factor found, if limit reached, we've failed
-			// otherwise `n' is prime
+			// no factor found, if limit reached, the least
+			// factor is large, otherwise `n' is prime
 			if (limit == dmax)
-			n = 0; // fail
+				n = rho_factor(n);
 		}
 	}
 
@@ -27,7 +27,7 @@ volatile FLAG WaitForLcd;
 #endif
 
 #ifdef USECURSES
-static unsigned char dots[400];
+static INSTANCE unsigned char dots[400];
 #ifdef __GNUC__
 #pragma GCC diagnostic ignored "-Wformat"
 #pragma GCC diagnostic ignored "-Wformat-extra-args"
@@ -540,7 +540,7 @@ void finish_display(void) {
 extern const char *pretty(unsigned char);
 
 static char *cleanse(const char *s) {
-        static char res[50];
+        static INSTANCE char res[50];
         char *p;
 
         for (p=res; *s != '\0'; s++) {
@@ -17,18 +17,24 @@
 #include "matrix.h"
 #include "decn.h"
 #include "consts.h"
+#include "stats.h"
 #include "decNumber/decimal128.h"
 
 #define MAX_DIMENSION	100
 #define MAX_SQUARE	10
 
+/* Number of unpacked elements the multiply kernel keeps per operand.
+ * The emulators can hold a whole operand, the real hardware hasn't the
+ * stack space for blocks and multiplies element by element.
+ */
+#ifndef REALBUILD
+#define MATRIX_BLOCK	MAX_DIMENSION
+#endif
+
 static int matrix_idx(int row, int col, int ncols) {
 	return col + row * ncols;
 }
 		
-static void matrix_get(decNumber *r, const decimal64 *base, int row, int col, int ncols) {
-	decimal64ToNumber(base + matrix_idx(row, col, ncols), r);
-}
 
 /* Check if a matrix fits into the available registers or not.
  * Raise an error if not.
@@ -171,6 +177,25 @@ decNumber *matrix_copy(decNumber *r, const decNumber *y, const decNumber *x) {
 }
 
 
+#ifdef BULK_RANDOM
+/* Fill the matrix in Y with random numbers, X selects the distribution.
+ */
+decNumber *matrix_random(decNumber *r, const decNumber *y, const decNumber *x) {
+	int rows, cols, kind;
+	decimal64 *base = matrix_decomp(y, &rows, &cols);
+
+	if (base == NULL)
+		return NULL;
+	kind = dn_to_int(x);
+	if (! is_int(x) || kind < RANDOM_UNIFORM || kind > RANDOM_EXPONENTIAL) {
+		report_err(ERR_RANGE);
+		return NULL;
+	}
+	stats_random_fill(base, rows * cols, kind);
+	return decNumberCopy(r, y);
+}
+#endif
+
 static decNumber *matrix_do_loop(decNumber *r, int low, int high, int step, int up) {
 	decNumber z;
 	int i;
@@ -292,11 +317,99 @@ decNumber *matrix_getrc(decNumber *res, const decNumber *m) {
 	return res;
 }
 
+/* Kernels working on packed matrices.
+ */
+
+// y = y + x * k over n elements
+void matrix_axpy(decimal64 *y, const decimal64 *x, const decNumber *k, int n) {
+	decNumber s, t, u;
+	int i;
+
+	for (i=0; i<n; i++) {
+		decimal64ToNumber(x + i, &s);
+		dn_multiply(&t, &s, k);
+		decimal64ToNumber(y + i, &s);
+		dn_add(&u, &s, &t);
+		packed_from_number(y + i, &u);
+	}
+}
+
+// x = x * k over n elements
+void matrix_scale(decimal64 *x, const decNumber *k, int n) {
+	decNumber s, t;
+	int i;
+
+	for (i=0; i<n; i++) {
+		decimal64ToNumber(x + i, &s);
+		dn_multiply(&t, &s, k);
+		packed_from_number(x + i, &t);
+	}
+}
+
+/* c = a * b where a is n by m and b is m by p, or c = transpose(a) * b
+ * if a is stored as m by n.  c mustn't overlap either operand.
+ * The sums are accumulated at the full working precision and rounded
+ * once when they are packed.
+ */
+#ifdef REALBUILD
+void matrix_gemm(decimal64 *c, const decimal64 *a, const decimal64 *b, int n, int m, int p, int transpose) {
+	decNumber sum, s, t, u;
+	int i, j, k;
+
+	for (i=0; i<n; i++)
+		for (j=0; j<p; j++) {
+			decNumberZero(&sum);
+			for (k=0; k<m; k++) {
+				decimal64ToNumber(a + (transpose ? matrix_idx(k, i, n) : matrix_idx(i, k, m)), &s);
+				decimal64ToNumber(b + matrix_idx(k, j, p), &t);
+				dn_multiply(&u, &s, &t);
+				dn_add(&sum, &sum, &u);
+			}
+			packed_from_number(c++, &sum);
+		}
+}
+#else
+/* The operands are unpacked into blocks of decNumbers first so that each
+ * element is decoded once instead of once per product.  A row of a is held
+ * against a tile of b; when m fits in the block the tile holds whole columns
+ * and is unpacked only once per column block.
+ */
+void matrix_gemm(decimal64 *c, const decimal64 *a, const decimal64 *b, int n, int m, int p, int transpose) {
+	decNumber av[MATRIX_BLOCK], bv[MATRIX_BLOCK], sum[MATRIX_BLOCK];
+	decNumber t;
+	const int kn = m < MATRIX_BLOCK ? m : MATRIX_BLOCK;
+	const int jn = MATRIX_BLOCK / kn;
+	int i, j, j0, jl, k, k0, kl;
+
+	for (j0=0; j0<p; j0+=jn) {
+		jl = p - j0 < jn ? p - j0 : jn;
+		for (i=0; i<n; i++) {
+			for (j=0; j<jl; j++)
+				decNumberZero(sum + j);
+			for (k0=0; k0<m; k0+=kn) {
+				kl = m - k0 < kn ? m - k0 : kn;
+				if (i == 0 || kn < m)
+					for (k=0; k<kl; k++)
+						for (j=0; j<jl; j++)
+							decimal64ToNumber(b + matrix_idx(k0 + k, j0 + j, p), bv + matrix_idx(j, k, kl));
+				for (k=0; k<kl; k++)
+					decimal64ToNumber(a + (transpose ? matrix_idx(k0 + k, i, n) : matrix_idx(i, k0 + k, m)), av + k);
+				for (j=0; j<jl; j++)
+					for (k=0; k<kl; k++) {
+						dn_multiply(&t, av + k, bv + matrix_idx(j, k, kl));
+						dn_add(sum + j, sum + j, &t);
+					}
+			}
+			for (j=0; j<jl; j++)
+				packed_from_number(c + matrix_idx(i, j0 + j, p), sum + j);
+		}
+	}
+}
+#endif
+
 // a = a + b * k -- generalised matrix add and subtract
 decNumber *matrix_genadd(decNumber *r, const decNumber *k, const decNumber *b, const decNumber *a) {
 	int arows, acols, brows, bcols;
-	decNumber s, t, u;
-	int i;
 
 	decimal64 *abase = matrix_decomp(a, &arows, &acols);
 	decimal64 *bbase = matrix_decomp(b, &brows, &bcols);
@@ -306,13 +419,7 @@ decNumber *matrix_genadd(decNumber *r, const decNumber *k, const decNumber *b, c
 		report_err(ERR_MATRIX_DIM);
 		return NULL;
 	}
-	for (i=0; i<arows*acols; i++) {
-		decimal64ToNumber(bbase + i, &s);
-		dn_multiply(&t, &s, k);
-		decimal64ToNumber(abase + i, &s);
-		dn_add(&u, &t, &s);
-		packed_from_number(abase + i, &u);
-	}
+	matrix_axpy(abase, bbase, k, arows * acols);
 	return decNumberCopy(r, a);
 }
 
@@ -320,11 +427,8 @@ decNumber *matrix_genadd(decNumber *r, const decNumber *k, const decNumber *b, c
 // Matrix multiply c = a * b, c can be a or b or overlap either
 decNumber *matrix_multiply(decNumber *r, const decNumber *a, const decNumber *b, const decNumber *c) {
 	int arows, acols, brows, bcols;
-	decNumber sum, s, t, u;
 	int creg;
-	int i, j, k;
 	decimal64 result[MAX_DIMENSION];
-	decimal64 *rp = result;
 	decimal64 *abase = matrix_decomp(a, &arows, &acols);
 	decimal64 *bbase = matrix_decomp(b, &brows, &bcols);
 
@@ -339,17 +443,7 @@ decNumber *matrix_multiply(decNumber *r, const decNumber *a, const decNumber *b,
 		return NULL;
 
         busy();
-	for (i=0; i<arows; i++)
-		for (j=0; j<bcols; j++) {
-			decNumberZero(&sum);
-			for (k=0; k<acols; k++) {
-				matrix_get(&s, abase, i, k, acols);
-				matrix_get(&t, bbase, k, j, bcols);
-				dn_multiply(&u, &s, &t);
-				dn_add(&sum, &sum, &u);
-			}
-			packed_from_number(rp++, &sum);
-		}
+	matrix_gemm(result, abase, bbase, arows, acols, bcols, 0);
 	xcopy(get_reg_n(creg), result, sizeof(decimal64) * arows * bcols);
 	return r;
 }
@@ -408,11 +502,7 @@ badrow:		report_err(ERR_RANGE);
 	r1 = base + i * cols;
 
 	if (op == OP_MAT_ROW_MUL) {
-		for (i=0; i<cols; i++) {
-			decimal64ToNumber(r1, &t);
-			dn_multiply(&m, &zdn, &t);
-			packed_from_number(r1++, &m);
-		}
+		matrix_scale(r1, &zdn, cols);
 	} else {
 		i = dn_to_int(&zdn) - 1;
 		if (i < 0 || i >= rows)
@@ -422,15 +512,8 @@ badrow:		report_err(ERR_RANGE);
 		if (op == OP_MAT_ROW_SWAP) {
 			for (i=0; i<cols; i++)
 				swap_reg((REGISTER *) r1++, (REGISTER *) r2++);
-		} else {
-			for (i=0; i<cols; i++) {
-				decimal64ToNumber(r1, &ydn);
-				decimal64ToNumber(r2++, &zdn);
-				dn_multiply(&m, &zdn, &t);
-				dn_add(&zdn, &ydn, &m);
-				packed_from_number(r1++, &zdn);
-			}
-		}
+		} else
+			matrix_axpy(r1, r2, &t, cols);
 	}
 }
 #endif
@@ -588,6 +671,55 @@ static int matrix_lu_check(const decNumber *m, decimal128 *mat, decimal64 **mbas
 	return rows;
 }
 
+#ifdef LU_CACHE
+#include <string.h>
+
+/* The last matrix decomposed, kept in its packed form, and its decomposition.
+ * The cache is used only while the registers still hold exactly the packed
+ * values it was made from, so nothing that stores to them needs to know.
+ */
+static INSTANCE struct _lu_cache {
+	int n;
+	int sign;
+	unsigned char pivots[MAX_SQUARE];
+	decimal64 packed[MAX_SQUARE*MAX_SQUARE];
+	decimal128 lu[MAX_SQUARE*MAX_SQUARE];
+} LUCache;
+#endif
+
+/* Extract the matrix into mat and LU decompose it there.  Return the
+ * dimensionality or 0 on error, the pivots in pivots if not null and
+ * the parity of the pivots or zero if singular in sign.
+ */
+static int matrix_lu(const decNumber *m, decimal128 *mat, unsigned char *pivots, decimal64 **mbase, int *sign) {
+	decimal64 *base;
+	int n;
+
+#ifdef LU_CACHE
+	n = matrix_lu_check(m, NULL, &base);
+	if (n == 0)
+		return 0;
+	if (LUCache.n != n || memcmp(LUCache.packed, base, n * n * sizeof(decimal64)) != 0) {
+		matrix_lu_check(m, LUCache.lu, NULL);
+		xcopy(LUCache.packed, base, n * n * sizeof(decimal64));
+		LUCache.sign = LU_decomposition(LUCache.lu, LUCache.pivots, n);
+		LUCache.n = n;
+	}
+	xcopy(mat, LUCache.lu, n * n * sizeof(decimal128));
+	if (pivots != NULL)
+		xcopy(pivots, LUCache.pivots, n);
+	*sign = LUCache.sign;
+#else
+	n = matrix_lu_check(m, mat, &base);
+	if (n == 0)
+		return 0;
+	*sign = LU_decomposition(mat, pivots, n);
+#endif
+	if (mbase != NULL)
+		*mbase = base;
+	return n;
+}
+
 /* Calculate the determinant of a matrix by performing the LU decomposition
  * and multiplying the diagonal elements of the upper triangular portion.
  * Also adjust for the parity of the number of pivots.
@@ -597,12 +729,10 @@ decNumber *matrix_determinant(decNumber *r, const decNumber *m) {
 	decimal128 mat[MAX_SQUARE*MAX_SQUARE];
 	decNumber t;
 
-	n = matrix_lu_check(m, mat, NULL);
+	n = matrix_lu(m, mat, NULL, NULL, &i);
 	if (n == 0)
 		return NULL;
 
-	i = LU_decomposition(mat, NULL, n);
-
 	int_to_dn(r, i);
 	for (i=0; i<n; i++) {
 		matrix_get128(&t, mat, i, i, n);
@@ -624,11 +754,9 @@ void matrix_inverse(enum nilop op) {
 	const decimal64 *b[MAX_SQUARE];
 
 	getX(x);
-	n = matrix_lu_check(x, mat, &base);
+	n = matrix_lu(x, mat, pivots, &base, &i);
 	if (n == 0)
 		return;
-
-	i = LU_decomposition(mat, pivots, n);
 	if (i == 0) {
 		report_err(ERR_SINGULAR);
 		return;
@@ -646,14 +774,14 @@ void matrix_inverse(enum nilop op) {
 /* Solve a system of linear equations Ac = b
  */
 decNumber *matrix_linear_eqn(decNumber *r, const decNumber *a, const decNumber *b, const decNumber *c) {
-	int n, i, brows, bcols, creg;
+	int n, i, sign, brows, bcols, creg;
 	decimal128 mat[MAX_SQUARE*MAX_SQUARE];
 	decimal64 *bbase, *cbase;
 	decNumber cv[MAX_SQUARE];
 	unsigned char pivots[MAX_SQUARE];
 	const decimal64 *bv[MAX_SQUARE];
 
-	n = matrix_lu_check(a, mat, NULL);
+	n = matrix_lu(a, mat, pivots, NULL, &sign);
 	if (n == 0)
 		return NULL;
 
@@ -670,9 +798,8 @@ decNumber *matrix_linear_eqn(decNumber *r, const decNumber *a, const decNumber *
 		return NULL;
 	cbase = &(get_reg_n(creg)->s);
 
-	/* Everything is happy so far -- decompose */
-	i = LU_decomposition(mat, pivots, n);
-	if (i == 0) {
+	/* Everything is happy so far -- check the decomposition */
+	if (sign == 0) {
 		report_err(ERR_SINGULAR);
 		return NULL;
 	}
@@ -697,11 +824,9 @@ decNumber *matrix_lu_decomp(decNumber *r, const decNumber *m) {
 	decimal128 mat[MAX_SQUARE*MAX_SQUARE];
 	decimal64 *base;
 
-	n = matrix_lu_check(m, mat, &base);
+	n = matrix_lu(m, mat, pivots, &base, &sign);
 	if (n == 0)
 		return NULL;
-
-	sign = LU_decomposition(mat, pivots, n);
 	if (sign == 0) {
 		report_err(ERR_SINGULAR);
 		return NULL;
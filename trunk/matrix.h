@@ -34,6 +34,13 @@ extern void matrix_rowops(enum nilop op);
 extern void matrix_is_square(enum nilop op);
 extern void matrix_create(enum nilop op);
 extern decNumber *matrix_copy(decNumber *r, const decNumber *y, const decNumber *x);
+#ifdef BULK_RANDOM
+extern decNumber *matrix_random(decNumber *r, const decNumber *y, const decNumber *x);
+#endif
+
+extern void matrix_axpy(decimal64 *y, const decimal64 *x, const decNumber *k, int n);
+extern void matrix_scale(decimal64 *x, const decNumber *k, int n);
+extern void matrix_gemm(decimal64 *c, const decimal64 *a, const decimal64 *b, int n, int m, int p, int transpose);
 
 extern decNumber *matrix_determinant(decNumber *r, const decNumber *x);
 extern decNumber *matrix_lu_decomp(decNumber *r, const decNumber *x);
@@ -29,7 +29,7 @@
  *  Where will the next data be printed?
  *  Columns are in pixel units from 0 to 165
  */
-unsigned int PrinterColumn;
+INSTANCE unsigned int PrinterColumn;
 
 /*
  *  Print to IR or serial port, depending on the PMODE setting
@@ -687,22 +687,42 @@ void cmdplotprint( unsigned int arg, enum rarg op )
 #define UDPPORT 5025
 #define UDPHOST "127.0.0.1"
 
-int put_ir( int c )
-{
-	int s;
-	WSADATA ws;
-	struct sockaddr_in sa;
+/*
+ *  Bytes are collected and sent a line at a time over a socket that stays open.
+ *  The heartbeat sends what is left of an unfinished line.
+ */
+#define IR_BUFFER_SIZE 256
 
-	set_IO_annunciator();
-	WSAStartup( 0x0101, &ws );
+static SOCKET IrSocket = INVALID_SOCKET;
+static struct sockaddr_in IrAddress;
+static char IrBuffer[ IR_BUFFER_SIZE ];
+static int IrLength;
 
-	sa.sin_family = AF_INET;
-	sa.sin_port = htons( UDPPORT );
-	sa.sin_addr.s_addr = inet_addr( UDPHOST );
+void flush_ir( void )
+{
+	if ( IrLength == 0 ) {
+		return;
+	}
+	if ( IrSocket == INVALID_SOCKET ) {
+		WSADATA ws;
 
-	s = socket( AF_INET, SOCK_DGRAM, 0 );
-	sendto( s, (const char *) &c, 1, 0, (struct sockaddr *) &sa, sizeof( struct sockaddr_in ) );
-	closesocket( s );
+		WSAStartup( 0x0101, &ws );
+		IrAddress.sin_family = AF_INET;
+		IrAddress.sin_port = htons( UDPPORT );
+		IrAddress.sin_addr.s_addr = inet_addr( UDPHOST );
+		IrSocket = socket( AF_INET, SOCK_DGRAM, 0 );
+	}
+	sendto( IrSocket, IrBuffer, IrLength, 0, (struct sockaddr *) &IrAddress, sizeof( struct sockaddr_in ) );
+	IrLength = 0;
+}
+
+int put_ir( int c )
+{
+	set_IO_annunciator();
+	IrBuffer[ IrLength++ ] = (char) c;
+	if ( c == '\n' || c == 0x04 || IrLength == IR_BUFFER_SIZE ) {
+		flush_ir();
+	}
 	return 0;
 }
 
@@ -52,12 +52,17 @@ extern void cmdplotprint( unsigned int arg, enum rarg op );
 
 // Implemented by the hardware layer
 extern int put_ir( int byte );
+#if defined(QTGUI) || defined(WINGUI)
+extern void flush_ir( void );
+#else
+#define flush_ir() /**/
+#endif
 
 #ifdef REALBUILD
 #define PRINT_DELAY 18	// 1.8 seconds
 extern volatile SMALL_INT PrintDelay;
 #endif
-extern unsigned int PrinterColumn;
+extern INSTANCE unsigned int PrinterColumn;
 
 #ifndef INFRARED
 #define print_trace( op, phase ) /**/
@@ -0,0 +1,398 @@
+/* This file is part of 34S.
+ *
+ * 34S is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * 34S is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with 34S.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ *  Instruction level profiler for the console emulator: "calc batch -P file"
+ *
+ *  Every program step is charged with the host time from its start to the
+ *  start of the next step and with the part of it spent inside the decNumber
+ *  library.  The costs are accumulated per opcode, per program address and
+ *  per node of a call tree.  A call starts with a GSB/XEQ or an XROM entry
+ *  from gsbgto() and ends when the return stack pointer drops above the
+ *  pushed return address, which covers RTN, POPUSR and cleared stacks alike.
+ *  A routine is known by the address of its call target, so code reached
+ *  by GTO is charged to the routine that jumped.
+ *
+ *  The decNumber library is compiled with -finstrument-functions when the
+ *  profiler is built, only the outermost library call is timed.
+ */
+#include "xeq.h"
+#include "profile.h"
+
+#ifdef PROFILER
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define PROFILE_NODES	4096
+#define PROFILE_DEPTH	256
+
+typedef struct _profile_cost {
+	unsigned long long int count;
+	unsigned long long int ns;		/* host time */
+	unsigned long long int dn_ns;		/* thereof inside decNumber */
+} PROFILE_COST;
+
+typedef struct _profile_node {
+	unsigned int pc;			/* call target, 0 for the top level */
+	int parent, child, sibling;
+	unsigned long long int calls;
+	PROFILE_COST self, total;
+} PROFILE_NODE;
+
+int Profiling;
+
+static PROFILE_COST ProfOp[0x10000];
+static PROFILE_COST ProfStep[0x10000];
+static PROFILE_NODE ProfNode[PROFILE_NODES];
+static int ProfNodes = 1;
+
+/* Open calls and the return stack pointer after their push */
+static struct {
+	int sp, node;
+} ProfStack[PROFILE_DEPTH];
+static int ProfDepth;
+
+/* A call from gsbgto() becomes a node when its first step executes */
+static int ProfPending, ProfPendingSp;
+static unsigned int ProfPendingPc;
+
+/* The step currently being timed */
+static int ProfLast, ProfLastNode;
+static unsigned int ProfLastKey, ProfLastPc;
+static unsigned long long int ProfStamp;
+
+/* decNumber time since the last step */
+static int ProfDnDepth;
+static unsigned long long int ProfDnStart, ProfDn;
+
+static unsigned long long int profile_ns(void)
+{
+	struct timespec t;
+
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return (unsigned long long int) t.tv_sec * 1000000000ULL + t.tv_nsec;
+}
+
+/*
+ *  Hooks for the instrumented decNumber library
+ */
+void __attribute__((no_instrument_function)) __cyg_profile_func_enter(void *fn, void *site)
+{
+	if (ProfDnDepth++ == 0 && Profiling)
+		ProfDnStart = profile_ns();
+}
+
+void __attribute__((no_instrument_function)) __cyg_profile_func_exit(void *fn, void *site)
+{
+	if (--ProfDnDepth == 0 && Profiling)
+		ProfDn += profile_ns() - ProfDnStart;
+}
+
+/*
+ *  Arguments and alpha characters don't make a different opcode
+ */
+static unsigned int profile_key(opcode op)
+{
+	op &= 0xffff;
+	if (isDBL(op) || isRARG(op))
+		return op & 0xff00;
+	return op;
+}
+
+static void profile_add(PROFILE_COST *c, unsigned long long int ns, unsigned long long int dn_ns)
+{
+	c->count++;
+	c->ns += ns;
+	c->dn_ns += dn_ns;
+}
+
+/*
+ *  Close the step being timed
+ */
+static void profile_charge(void)
+{
+	const unsigned long long int now = profile_ns();
+
+	if (ProfLast) {
+		const unsigned long long int ns = now - ProfStamp;
+
+		profile_add(ProfOp + ProfLastKey, ns, ProfDn);
+		profile_add(ProfStep + ProfLastPc, ns, ProfDn);
+		profile_add(&ProfNode[ProfLastNode].self, ns, ProfDn);
+	}
+	ProfStamp = now;
+	ProfDn = 0;
+}
+
+static int profile_child(int parent, unsigned int pc)
+{
+	int n;
+
+	for (n = ProfNode[parent].child; n != 0; n = ProfNode[n].sibling)
+		if (ProfNode[n].pc == pc)
+			return n;
+	if (ProfNodes == PROFILE_NODES)
+		return parent;
+	n = ProfNodes++;
+	ProfNode[n].pc = pc;
+	ProfNode[n].parent = parent;
+	ProfNode[n].sibling = ProfNode[parent].child;
+	ProfNode[parent].child = n;
+	return n;
+}
+
+/*
+ *  Called from xeq_single() before the step at pc executes
+ */
+void profile_step(opcode op, unsigned int pc)
+{
+	profile_charge();
+
+	while (ProfDepth > 0 && RetStkPtr > ProfStack[ProfDepth].sp)
+		ProfDepth--;
+	if (ProfPending) {
+		ProfPending = 0;
+		if (RetStkPtr <= ProfPendingSp && ProfDepth < PROFILE_DEPTH - 1) {
+			const int n = profile_child(ProfStack[ProfDepth].node, ProfPendingPc);
+
+			ProfNode[n].calls++;
+			ProfDepth++;
+			ProfStack[ProfDepth].sp = ProfPendingSp;
+			ProfStack[ProfDepth].node = n;
+		}
+	}
+	ProfLast = 1;
+	ProfLastKey = profile_key(op);
+	ProfLastPc = pc & 0xffff;
+	ProfLastNode = ProfStack[ProfDepth].node;
+}
+
+/*
+ *  Called from gsbgto() after the return address has been pushed.
+ *  XEQUSR pushes some data first, only the last push is the call.
+ */
+void profile_call(unsigned int pc)
+{
+	ProfPending = 1;
+	ProfPendingPc = pc;
+	ProfPendingSp = RetStkPtr;
+}
+
+/*
+ *  The program has stopped
+ */
+void profile_stop(void)
+{
+	profile_charge();
+	ProfLast = 0;
+	ProfDepth = 0;
+	ProfPending = 0;
+}
+
+/*
+ *  The report
+ */
+extern const char *pretty(unsigned char);
+extern const char *xrom_entry_name(unsigned int pc);	// console.c
+
+static void profile_name(FILE *f, const char *s)
+{
+	while (*s != '\0') {
+		const unsigned char c = *s++;
+		const char *m = pretty(c);
+
+		if (m == NULL)
+			putc(c, f);
+		else if (strcmp(m, "narrow-space") == 0 && (unsigned char) *s == c) {
+			putc(' ', f);
+			s++;
+		}
+		else
+			fprintf(f, "[%s]", m);
+	}
+}
+
+static void profile_opcode_name(FILE *f, unsigned int key)
+{
+	char buf[16];
+
+	xset(buf, '\0', sizeof(buf));
+	if (isRARG(key))
+		sncopy(buf, argcmds[RARG_CMD(key)].cmd, NAME_LEN);
+	else if (isDBL(key))
+		sncopy(buf, multicmds[opDBL(key)].cmd, NAME_LEN);
+	else
+		prt(key, buf);
+	profile_name(f, buf);
+}
+
+static void profile_step_name(FILE *f, unsigned int pc)
+{
+	char buf[16];
+
+	xset(buf, '\0', sizeof(buf));
+	profile_name(f, prt(getprog(pc), buf));
+}
+
+static void profile_routine_name(FILE *f, unsigned int pc)
+{
+	const char *name;
+
+	if (pc == 0)
+		fprintf(f, "(top level)");
+	else if (isXROM(pc)) {
+		name = xrom_entry_name(pc);
+		if (name != NULL)
+			fprintf(f, "XLBL %s", name);
+		else
+			fprintf(f, "XROM %04x", pc & LIB_ADDR_MASK);
+	}
+	else {
+		fprintf(f, "%04x ", pc);
+		profile_step_name(f, pc);
+	}
+}
+
+static PROFILE_COST *ProfSort;
+
+static int profile_compare(const void *a, const void *b)
+{
+	const unsigned long long int x = ProfSort[*(const unsigned int *) a].ns;
+	const unsigned long long int y = ProfSort[*(const unsigned int *) b].ns;
+
+	return x < y ? 1 : x > y ? -1 : 0;
+}
+
+/*
+ *  Nonzero entries of a cost table, most expensive first
+ */
+static unsigned int profile_sorted(PROFILE_COST *c, unsigned int size, unsigned int *index)
+{
+	unsigned int i, n = 0;
+
+	for (i = 0; i < size; i++)
+		if (c[i].count != 0)
+			index[n++] = i;
+	ProfSort = c;
+	qsort(index, n, sizeof(*index), &profile_compare);
+	return n;
+}
+
+static void profile_cost(FILE *f, const PROFILE_COST *c, unsigned long long int total)
+{
+	fprintf(f, "%12llu %12.3f %12.3f %6.2f  ", c->count, c->ns / 1e6, c->dn_ns / 1e6,
+		total == 0 ? 0.0 : 100.0 * c->ns / total);
+}
+
+static void profile_tree(FILE *f, int n, int level, unsigned long long int total)
+{
+	const PROFILE_NODE *p = ProfNode + n;
+	int c;
+
+	fprintf(f, "%12llu %12.3f %12.3f %12.3f %6.2f  %*s", p->calls, p->total.ns / 1e6,
+		p->self.ns / 1e6, p->total.dn_ns / 1e6,
+		total == 0 ? 0.0 : 100.0 * p->total.ns / total, 2 * level, "");
+	profile_routine_name(f, p->pc);
+	putc('\n', f);
+	for (c = p->child; c != 0; c = ProfNode[c].sibling)
+		profile_tree(f, c, level + 1, total);
+}
+
+void profile_report(FILE *f)
+{
+	static unsigned int index[0x10000];
+	static PROFILE_COST routine[PROFILE_NODES];
+	static unsigned int routine_pc[PROFILE_NODES];
+	static unsigned long long int routine_total[PROFILE_NODES];
+	unsigned long long int total;
+	unsigned int i, n, routines = 0;
+	int j, k;
+
+	/* Inclusive costs, children are always allocated after their parents */
+	for (j = 0; j < ProfNodes; j++)
+		ProfNode[j].total = ProfNode[j].self;
+	for (j = ProfNodes - 1; j > 0; j--) {
+		PROFILE_COST *const t = &ProfNode[ProfNode[j].parent].total;
+
+		t->count += ProfNode[j].total.count;
+		t->ns += ProfNode[j].total.ns;
+		t->dn_ns += ProfNode[j].total.dn_ns;
+	}
+	total = ProfNode[0].total.ns;
+
+	fprintf(f, "%llu steps, %.3f ms, %.3f ms in decNumber\n",
+		ProfNode[0].total.count, total / 1e6, ProfNode[0].total.dn_ns / 1e6);
+
+	fprintf(f, "\nFlat profile by opcode\n\n%12s %12s %12s %6s  %s\n",
+		"count", "ms", "decNumber ms", "%", "opcode");
+	n = profile_sorted(ProfOp, 0x10000, index);
+	for (i = 0; i < n; i++) {
+		profile_cost(f, ProfOp + index[i], total);
+		profile_opcode_name(f, index[i]);
+		putc('\n', f);
+	}
+
+	fprintf(f, "\nFlat profile by step\n\n%12s %12s %12s %6s  %s\n",
+		"count", "ms", "decNumber ms", "%", "step");
+	n = profile_sorted(ProfStep, 0x10000, index);
+	for (i = 0; i < n; i++) {
+		profile_cost(f, ProfStep + index[i], total);
+		if (isXROM(index[i]))
+			fprintf(f, "XROM %04x ", index[i] & LIB_ADDR_MASK);
+		else
+			fprintf(f, "%04x ", index[i]);
+		profile_step_name(f, index[i]);
+		putc('\n', f);
+	}
+
+	/* Self time per routine, the inclusive time of recursive calls only counts once */
+	for (j = 0; j < ProfNodes; j++) {
+		const PROFILE_NODE *const p = ProfNode + j;
+
+		for (i = 0; i < routines && routine_pc[i] != p->pc; i++)
+			;
+		if (i == routines) {
+			routine_pc[routines++] = p->pc;
+			xset(routine + i, 0, sizeof(*routine));
+			routine_total[i] = 0;
+		}
+		routine[i].count += p->self.count;
+		routine[i].ns += p->self.ns;
+		routine[i].dn_ns += p->self.dn_ns;
+		for (k = p->parent; j != 0 && k != 0 && ProfNode[k].pc != p->pc; k = ProfNode[k].parent)
+			;
+		if (j == 0 || k == 0)
+			routine_total[i] += p->total.ns;
+	}
+	fprintf(f, "\nFlat profile by routine\n\n%12s %12s %12s %6s %12s  %s\n",
+		"steps", "self ms", "decNumber ms", "%", "total ms", "routine");
+	for (i = 0; i < routines; i++)
+		index[i] = i;
+	ProfSort = routine;
+	qsort(index, routines, sizeof(*index), &profile_compare);
+	for (i = 0; i < routines; i++) {
+		profile_cost(f, routine + index[i], total);
+		fprintf(f, "%12.3f  ", routine_total[index[i]] / 1e6);
+		profile_routine_name(f, routine_pc[index[i]]);
+		putc('\n', f);
+	}
+
+	fprintf(f, "\nCall tree\n\n%12s %12s %12s %12s %6s  %s\n",
+		"calls", "total ms", "self ms", "decNumber ms", "%", "routine");
+	profile_tree(f, 0, 0, total);
+}
+#endif
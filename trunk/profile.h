@@ -0,0 +1,47 @@
+/* This file is part of 34S.
+ *
+ * 34S is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * 34S is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with 34S.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __PROFILE_H__
+#define __PROFILE_H__
+
+/*
+ * Optional features are defined in features.h
+ */
+#include "features.h"
+
+#ifdef PROFILER
+#include <stdio.h>
+
+extern int Profiling;
+
+/*
+ * Hooks called from xeq.c, see profile.c for details
+ */
+extern void profile_step(opcode op, unsigned int pc);
+extern void profile_call(unsigned int pc);
+extern void profile_stop(void);
+extern void profile_report(FILE *f);
+
+#define PROFILE_STEP(op, pc)	do { if (Profiling) profile_step(op, pc); } while (0)
+#define PROFILE_CALL(pc)	do { if (Profiling) profile_call(pc); } while (0)
+#define PROFILE_STOP()		do { if (Profiling) profile_stop(); } while (0)
+#else
+#define PROFILE_STEP(op, pc)
+#define PROFILE_CALL(pc)
+#define PROFILE_STOP()
+#endif
+
+#endif
@@ -21,11 +21,13 @@
 #include "lcd.h"
 #include "stats.h"
 
+#define SOH 1
 #define STX 2
 #define ETX 3
 #define ENQ 5
 #define ACK 6
 #define NAK 0x15
+#define SYN 0x16
 #define MAXCONNECT 10
 #define CHARTIME 30
 
@@ -38,6 +40,29 @@
 #define TAG_SIGMA    0x4D53 // "SM"
 #define TAG_ALLMEM   0x4C41 // "AL"
 
+/*
+ *  Windowed transfers: frames of up to FRAME_LEN data bytes,
+ *  WINDOW of them may be unacknowledged.
+ */
+#define FRAME_LEN 64
+#define FRAME_RLE 0x80		// Frame data is run length encoded
+#define FRAME_END 0xff		// Frame number of the final reply
+#define WINDOW 4
+#define MAX_RETRIES 20
+#define FINAL_RETRIES 4		// ETX repeats, the final answer is awaited 5 * CHARTIME at most
+#define SILENCE (6 * CHARTIME)	// Receiver gives up, longer than all ETX repeats
+
+/*
+ *  The window bitmaps hold one bit per frame in an unsigned long, which has
+ *  32 bits on the device.  put_block() refuses blocks longer than DATA_LEN,
+ *  so no more than DATA_LEN / FRAME_LEN = 32 frames are ever numbered.
+ */
+#define FRAME_BIT(n) (1UL << (n))
+#define FRAME_MASK(frames) ((frames) == 0 ? 0UL : (FRAME_BIT((frames) - 1) << 1) - 1)
+#if DATA_LEN / FRAME_LEN > 32
+#error "Too many frames for the window bitmaps"
+#endif
+
 #define SERIAL_ANNUNCIATOR LIT_EQ
 
 #if defined(QTGUI) || defined(IOS) || defined(WINGUI)
@@ -52,9 +77,14 @@ extern void serial_unlock(void);
 /*
  *  Flags and hardware buffer for received data
  */
-volatile short InBuffer[ IN_BUFF_LEN ];
-volatile char InRead, InWrite, InCount;
-char SerialOn;
+INSTANCE volatile short InBuffer[ IN_BUFF_LEN ];
+INSTANCE volatile char InRead, InWrite, InCount;
+INSTANCE char SerialOn;
+
+/*
+ *  Set when both sides of the connection use windowed transfers
+ */
+static INSTANCE char Windowed;
 
 /*
  *  Handle the flag and the annunciator
@@ -194,7 +224,9 @@ int open_port_default( void )
 
 /*
  *  Connect to partner.
- *  Opens the port and sends ENQ until ACK is received.
+ *  Opens the port and sends SYN ENQ until ACK or SYN is received.
+ *  An older partner ignores the SYN and answers the ENQ with ACK,
+ *  a partner answering SYN can do windowed transfers.
  *  Returns non zero in case of failure.
  */
 static int connect( void )
@@ -203,13 +235,15 @@ static int connect( void )
 
 	if ( open_port_default() ) return 1;
 	do {
+		put_byte( SYN );
 		put_byte( ENQ );
 		c = get_byte();
-	} while ( c != ACK && c != R_BREAK && --i );
-	if ( c != ACK ) {
+	} while ( c != ACK && c != SYN && c != R_BREAK && --i );
+	if ( c != ACK && c != SYN ) {
 		close_port_reset_state();
 		return 1;
 	}
+	Windowed = ( c == SYN );
 	return 0;
 }
 
@@ -226,10 +260,22 @@ static int accept_connection( void )
 	if ( open_port_default() ) return 1;
 	while ( i-- ) {
 		int c = get_byte();
+		if ( c == SYN ) {
+			/*
+			 *  Partner offers windowed transfers, skip its ENQ
+			 */
+			get_byte();
+			clear_buffer();
+			put_byte( SYN );
+			flush_comm();
+			Windowed = 1;
+			return 0;
+		}
 		if ( c == ENQ ) {
 			clear_buffer();
 			put_byte( ACK );
 			flush_comm();
+			Windowed = 0;
 			return 0;
 		}
 		if ( c == R_BREAK ) break;
@@ -265,12 +311,227 @@ static int get_word( void )
 }
 
 
+/*
+ *  Run length encode the zeros in a frame: a zero byte is followed by
+ *  the number of zeros in the run, all other bytes are sent as they are.
+ *  Returns size if this doesn't make the frame any shorter.
+ */
+static int rle_encode( unsigned char *dest, const unsigned char *src, int size )
+{
+	int i = 0, j = 0;
+
+	while ( i < size ) {
+		const unsigned char c = src[ i++ ];
+		if ( j + ( c == 0 ) + 1 >= size ) {
+			return size;
+		}
+		dest[ j++ ] = c;
+		if ( c == 0 ) {
+			int run = 1;
+			while ( i < size && src[ i ] == 0 ) {
+				++i;
+				++run;
+			}
+			dest[ j++ ] = run;
+		}
+	}
+	return j;
+}
+
+
+/*
+ *  Expand a run length encoded frame.
+ *  Returns the number of bytes produced or -1 if the data doesn't fit.
+ */
+static int rle_decode( unsigned char *dest, int size, const unsigned char *src, int length )
+{
+	int i = 0, j = 0;
+
+	while ( i < length ) {
+		const unsigned char c = src[ i++ ];
+		int run = 1;
+		if ( c == 0 ) {
+			if ( i == length ) {
+				return -1;
+			}
+			run = src[ i++ ];
+		}
+		if ( j + run > size ) {
+			return -1;
+		}
+		while ( run-- ) {
+			dest[ j++ ] = c;
+		}
+	}
+	return j;
+}
+
+
+/*
+ *  Answer a frame: ACK or NAK, the frame number and its complement
+ */
+static void put_reply( int c, int n )
+{
+	put_byte( c );
+	put_byte( n );
+	put_byte( ~n );
+}
+
+
+/*
+ *  Receive the frame number of an answer.
+ *  Returns a negative value on a communication error or a damaged answer.
+ */
+static int get_reply_frame( void )
+{
+	int n = get_byte();
+	int m;
+
+	if ( n < 0 ) 
+		return n;
+	m = get_byte();
+	if ( m < 0 ) 
+		return m;
+	return ( n ^ m ) == 0xff ? n : R_ERROR;
+}
+
+
+/*
+ *  Transmit frame n of a block:
+ *    SOH, frame number, size | FRAME_RLE if encoded, data, CRC (16 bit, lsb first)
+ *  The CRC covers everything after the SOH.
+ */
+static void put_frame( const unsigned char *data, int length, int n )
+{
+	unsigned char frame[ 2 + FRAME_LEN ];
+	const unsigned char *p = data + n * FRAME_LEN;
+	int i, size = length - n * FRAME_LEN;
+
+	if ( size > FRAME_LEN ) {
+		size = FRAME_LEN;
+	}
+	frame[ 0 ] = n;
+	i = rle_encode( frame + 2, p, size );
+	if ( i < size ) {
+		frame[ 1 ] = FRAME_RLE | i;
+		size = i;
+	}
+	else {
+		frame[ 1 ] = size;
+		xcopy( frame + 2, p, size );
+	}
+	size += 2;
+
+	busy();
+	put_byte( SOH );
+	for ( i = 0; i < size; ++i ) {
+		put_byte( frame[ i ] );
+	}
+	put_word( crc16( frame, size ) );
+}
+
+
+/*
+ *  Transmit the frames of a block, keeping up to WINDOW of them unacknowledged.
+ *  The partner answers each frame with ACK or NAK, the frame number and its complement.
+ *  A NAK resends that frame, no answer in time resends all unacknowledged frames.
+ *  The retry count is restored whenever a frame gets through.
+ *  Returns non zero in case of failure.
+ */
+static int put_frames( const unsigned char *data, int length )
+{
+	const int frames = ( length + FRAME_LEN - 1 ) / FRAME_LEN;
+	unsigned long acked = 0, pending = 0;
+	int next = 0, in_flight = 0, retries = MAX_RETRIES;
+	int c, n;
+
+	while ( acked != FRAME_MASK( frames ) ) {
+		while ( next < frames && in_flight < WINDOW ) {
+			put_frame( data, length, next );
+			pending |= FRAME_BIT( next );
+			++in_flight;
+			++next;
+		}
+		c = get_byte();
+		if ( c == ACK || c == NAK ) {
+			n = get_reply_frame();
+			if ( n == FRAME_END ) {
+				/*
+				 *  Partner gave up
+				 */
+				return 1;
+			}
+			if ( n < 0 || n >= frames || ( pending & FRAME_BIT( n ) ) == 0 ) {
+				continue;
+			}
+			if ( c == ACK ) {
+				acked |= FRAME_BIT( n );
+				pending &= ~FRAME_BIT( n );
+				--in_flight;
+				retries = MAX_RETRIES;
+			}
+			else {
+				if ( --retries == 0 ) {
+					return 1;
+				}
+				put_frame( data, length, n );
+			}
+		}
+		else if ( c == R_TIMEOUT ) {
+			if ( --retries == 0 ) {
+				return 1;
+			}
+			for ( n = 0; n < next; ++n ) {
+				if ( pending & FRAME_BIT( n ) ) {
+					put_frame( data, length, n );
+				}
+			}
+		}
+		else if ( c == R_BREAK ) {
+			return 1;
+		}
+	}
+	return 0;
+}
+
+
+/*
+ *  Send the ETX and wait for the partner's final answer to a windowed
+ *  transfer, skipping answers to frames sent more than once.
+ *  The ETX is repeated if the partner stays silent for a CHARTIME.
+ */
+static int get_final_reply( void )
+{
+	int c, n = 0, retries = FINAL_RETRIES + 1;
+
+	put_byte( ETX );
+	do {
+		c = recv_byte( CHARTIME );
+		if ( c == R_TIMEOUT && --retries != 0 ) {
+			put_byte( ETX );
+			continue;
+		}
+		if ( c < 0 ) {
+			return c;
+		}
+		if ( c != ACK && c != NAK ) {
+			continue;
+		}
+		n = get_reply_frame();
+		if ( n == R_BREAK ) {
+			return n;
+		}
+	} while ( n != FRAME_END );
+	return c;
+}
+
+
 /*
  *  Transmits block of data to the serial port.
  *  Returns non zero in case of error.
  *
  *  The protocol is as follows:
- *    Connect (Send ENQ, wait for ACK, see above)
+ *    Connect (Send SYN ENQ, wait for ACK or SYN, see above)
  *    Send tag (2 bytes)
  *    Send length (16 bit, lsb first)
  *    Send CRC ^ tag (16 bit, lsb first)
@@ -279,14 +540,26 @@ static int get_word( void )
  *    Wait for ACK
  *
  *    If a NAK is received while sending the transfer is aborted.
+ *
+ *  If the partner answered SYN, the data is sent in frames (see put_frames)
+ *  and the final ACK or NAK is answered like a frame numbered FRAME_END.
+ *
+ *  Blocks longer than DATA_LEN, which the calculator can't receive, are refused.
  */
 static void put_block( unsigned short tag, unsigned short length, const void *data )
 {
 	const unsigned short crc = crc16( data, length ) ^ tag;
 	unsigned char *p = (unsigned char *) data;
-	int ret = connect();
-	int c;
+	int ret, c;
 
+	if ( length > DATA_LEN ) {
+		/*
+		 *  The receiver can't take it and the frame numbers would overflow
+		 */
+		report_err( ERR_TOO_LONG );
+		return;
+	}
+	ret = connect();
 	if ( ret == 0 ) {
 		/*
 		 *  We are connected, send data
@@ -295,18 +568,26 @@ static void put_block( unsigned short tag, unsigned short length, const void *da
 		put_word( tag );
 		put_word( length );
 		put_word( crc );
-		while ( length-- && ret == 0 ) {
-			busy();
-			put_byte( *p++ );
-			if ( (char) length == 0 ) {
-				c = recv_byte( 0 );
-				ret = ( c == NAK || c == R_BREAK );
+		if ( Windowed ) {
+			ret = put_frames( p, length );
+			if ( ret == 0 ) {
+				ret = ACK != get_final_reply();
 			}
 		}
-		clear_buffer();
-		put_byte( ETX );
-		if ( ret || ACK != recv_byte( 5 * CHARTIME ) ) {
-			ret = 1;
+		else {
+			while ( length-- && ret == 0 ) {
+				busy();
+				put_byte( *p++ );
+				if ( (char) length == 0 ) {
+					c = recv_byte( 0 );
+					ret = ( c == NAK || c == R_BREAK );
+				}
+			}
+			clear_buffer();
+			put_byte( ETX );
+			if ( ret || ACK != recv_byte( 5 * CHARTIME ) ) {
+				ret = 1;
+			}
 		}
 		close_port_reset_state();
 	}
@@ -319,6 +600,60 @@ static void put_block( unsigned short tag, unsigned short length, const void *da
 	return;
 }
 
+/*
+ *  Receive a frame after its SOH and store its data in the block.
+ *  Answers ACK or NAK and the frame number and marks good frames as received.
+ *  A frame too mangled to be answered is ignored, the partner will send it again.
+ *  Returns a negative value if a byte couldn't be received.
+ */
+static int recv_frame( unsigned char *buffer, int length, unsigned long *received )
+{
+	unsigned char frame[ 2 + FRAME_LEN ];
+	int i, c, n, size, crc;
+
+	for ( i = 0; i < 2; ++i ) {
+		c = get_byte();
+		if ( c < 0 ) 
+			return c;
+		frame[ i ] = c;
+	}
+	size = frame[ 1 ] & ~FRAME_RLE;
+	if ( size > FRAME_LEN ) 
+		return 0;
+	for ( i = 0; i < size; ++i ) {
+		c = get_byte();
+		if ( c < 0 ) 
+			return c;
+		frame[ i + 2 ] = c;
+	}
+	crc = get_word();
+	if ( crc < 0 ) 
+		return crc;
+
+	n = frame[ 0 ];
+	c = NAK;
+	if ( n * FRAME_LEN < length && crc == crc16( frame, size + 2 ) ) {
+		unsigned char *dest = buffer + n * FRAME_LEN;
+		int expected = length - n * FRAME_LEN;
+
+		if ( expected > FRAME_LEN ) 
+			expected = FRAME_LEN;
+		if ( frame[ 1 ] & FRAME_RLE ) {
+			if ( rle_decode( dest, expected, frame + 2, size ) == expected ) 
+				c = ACK;
+		}
+		else if ( size == expected ) {
+			xcopy( dest, frame + 2, size );
+			c = ACK;
+		}
+	}
+	if ( c == ACK ) 
+		*received |= FRAME_BIT( n );
+	put_reply( c, n );
+	return 0;
+}
+
+
 /*
  *  Receive block from the serial port and validate the checksum.
  *  If the checksum doesn't match, set error condition.
@@ -362,13 +697,31 @@ void recv_any( enum nilop op )
 		if ( crc < 0 ) 
 			goto err;
 
-		for ( i = 0; i < length; ++i ) {
+		if ( Windowed ) {
+			/*
+			 *  Collect the frames in any order and answer the ones
+			 *  sent again until the ETX arrives. Anything else is noise.
+			 */
+			const unsigned long all = FRAME_MASK( ( length + FRAME_LEN - 1 ) / FRAME_LEN );
+			unsigned long received = 0;
+
+			do {
+				c = recv_byte( SILENCE );
+				if ( c == R_TIMEOUT || c == R_BREAK ) 
+					goto err;
+				if ( c == SOH && recv_frame( buffer, length, &received ) == R_BREAK ) 
+					goto err;
+			} while ( received != all || c != ETX );
+		}
+		else {
+			for ( i = 0; i < length; ++i ) {
+				c = get_byte();
+				if ( c < 0 ) 
+					goto err;
+				buffer[ i ] = c;
+			}
 			c = get_byte();
-			if ( c < 0 ) 
-				goto err;
-			buffer[ i ] = c;
 		}
-		c = get_byte();
 		if ( c != ETX ) 
 			goto err;
 
@@ -401,6 +754,7 @@ void recv_any( enum nilop op )
 				  goto invalid;
 			}
 			dest = &PersistentRam;
+			invalidate_label_index( REGION_RAM );
 			DispMsg = "All RAM";
 			break;
 
@@ -460,7 +814,10 @@ void recv_any( enum nilop op )
 		/*
 		 *  Send reply to partner
 		 */
-		put_byte( c );
+		if ( Windowed ) 
+			put_reply( c, FRAME_END );
+		else 
+			put_byte( c );
 		close_port_reset_state();
 	}
 }
@@ -25,7 +25,7 @@
 #define R_BREAK (-3)
 
 // Global flags
-extern char SerialOn;
+extern INSTANCE char SerialOn;
 
 // User visible routines
 extern void send_program( enum nilop op );
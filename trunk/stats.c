@@ -29,7 +29,7 @@
 /*
  *  Define register block
  */
-STAT_DATA *StatRegs;
+INSTANCE STAT_DATA *StatRegs;
 
 #define sigmaN		(StatRegs->sN)
 #define sigmaX		(StatRegs->sX)
@@ -49,7 +49,7 @@ STAT_DATA *StatRegs;
 /*
  *  Actual size of this block (may be zero)
  */
-SMALL_INT SizeStatRegs;
+INSTANCE SMALL_INT SizeStatRegs;
 
 /*
  *  Handle block (de)allocation
@@ -236,6 +236,149 @@ int sigma_plus_x( const decNumber *x) {
 	return sigmaN;
 }
 
+#ifdef SIGMA_BULK
+/*
+ *  Bulk loading for the emulators.  The sums stay unpacked at full working
+ *  precision, each with a Neumaier compensation term, and are only packed
+ *  into the register block at the end.  The first four are the decimal128
+ *  sums, the rest are decimal64, both in the order of STAT_DATA.
+ */
+enum {
+	BULK_X2Y, BULK_X2, BULK_Y2, BULK_XY,
+	BULK_X, BULK_Y, BULK_LNX, BULK_LNXLNX, BULK_LNY, BULK_LNYLNY,
+	BULK_LNXLNY, BULK_XLNY, BULK_YLNX
+};
+
+static void bulk_sums(decimal128 *wide[4], decimal64 *narrow[SIGMA_BULK_SUMS - 4]) {
+	wide[0] = &sigmaX2Y;	wide[1] = &sigmaX2;
+	wide[2] = &sigmaY2;	wide[3] = &sigmaXY;
+	narrow[0] = &sigmaX;	narrow[1] = &sigmaY;
+	narrow[2] = &sigmalnX;	narrow[3] = &sigmalnXlnX;
+	narrow[4] = &sigmalnY;	narrow[5] = &sigmalnYlnY;
+	narrow[6] = &sigmalnXlnY;
+	narrow[7] = &sigmaXlnY;	narrow[8] = &sigmaYlnX;
+}
+
+/* Start from the current data, if any, just as sigma+ would.
+ */
+void sigma_bulk_start(SIGMA_BULK_DATA *b) {
+	decimal128 *wide[4];
+	decimal64 *narrow[SIGMA_BULK_SUMS - 4];
+	int i;
+
+	b->n = 0;
+	decNumberZero(&b->x);
+	decNumberZero(&b->y);
+	for (i = 0; i < SIGMA_BULK_SUMS; i++) {
+		decNumberZero(&b->sum[i]);
+		decNumberZero(&b->comp[i]);
+	}
+	if (! State.have_stats || sigmaCheck())
+		return;
+	bulk_sums(wide, narrow);
+	for (i = 0; i < 4; i++)
+		decimal128ToNumber(wide[i], &b->sum[i]);
+	for (i = 4; i < SIGMA_BULK_SUMS; i++)
+		decimal64ToNumber(narrow[i - 4], &b->sum[i]);
+	b->n = sigmaN;
+}
+
+static void bulk_add(SIGMA_BULK_DATA *b, int i, const decNumber *a) {
+	decNumber t, u, v;
+	decNumber *const s = &b->sum[i];
+
+	dn_add(&t, s, a);
+	if (! decNumberIsSpecial(&t)) {
+		if (dn_abs_lt(a, dn_abs(&u, s)))
+			dn_add(&v, dn_subtract(&u, s, &t), a);
+		else
+			dn_add(&v, dn_subtract(&u, a, &t), s);
+		dn_add(&b->comp[i], &b->comp[i], &v);
+	}
+	decNumberCopy(s, &t);
+}
+
+/* Streamed data usually changes slowly, so take the logarithm of the ratio
+ * to the previous value when that's close to one.  The series in dn_ln()
+ * then needs a few terms and no square roots.
+ */
+static void bulk_ln(decNumber *r, const decNumber *x, decNumber *prev, decNumber *lnprev) {
+	decNumber q, t;
+
+	if (! dn_eq0(prev) && ! decNumberIsSpecial(x)) {
+		dn_divide(&q, x, prev);
+		dn_m1(&t, &q);
+		if (dn_abs_lt(&t, &const_0_1)) {
+			dn_add(r, lnprev, dn_ln(&t, &q));
+			decNumberCopy(prev, x);
+			decNumberCopy(lnprev, r);
+			return;
+		}
+	}
+	dn_ln(r, x);
+	if (decNumberIsSpecial(r))
+		decNumberZero(prev);
+	else {
+		decNumberCopy(prev, x);
+		decNumberCopy(lnprev, r);
+	}
+}
+
+static void bulk_mul(SIGMA_BULK_DATA *b, int i, const decNumber *x, const decNumber *y) {
+	decNumber t;
+
+	bulk_add(b, i, dn_multiply(&t, x, y));
+}
+
+void sigma_bulk_add(SIGMA_BULK_DATA *b, const decNumber *x, const decNumber *y) {
+	decNumber lx, ly, t;
+
+	b->n++;
+	bulk_add(b, BULK_X, x);
+	bulk_add(b, BULK_Y, y);
+	bulk_mul(b, BULK_X2, x, x);
+	bulk_mul(b, BULK_Y2, y, y);
+	bulk_mul(b, BULK_XY, x, y);
+	decNumberSquare(&t, x);
+	bulk_mul(b, BULK_X2Y, &t, y);
+
+	bulk_ln(&lx, x, &b->x, &b->lnx);
+	bulk_ln(&ly, y, &b->y, &b->lny);
+	bulk_add(b, BULK_LNX, &lx);
+	bulk_add(b, BULK_LNY, &ly);
+	bulk_mul(b, BULK_LNXLNX, &lx, &lx);
+	bulk_mul(b, BULK_LNYLNY, &ly, &ly);
+	bulk_mul(b, BULK_LNXLNY, &lx, &ly);
+	bulk_mul(b, BULK_XLNY, x, &ly);
+	bulk_mul(b, BULK_YLNX, y, &lx);
+}
+
+/* Write the sums to the register block, returns non-zero on error.
+ */
+int sigma_bulk_finish(SIGMA_BULK_DATA *b) {
+	decimal128 *wide[4];
+	decimal64 *narrow[SIGMA_BULK_SUMS - 4];
+	decNumber t;
+	int i;
+
+	if (sigmaAllocate())
+		return 1;
+	bulk_sums(wide, narrow);
+	for (i = 0; i < SIGMA_BULK_SUMS; i++) {
+		if (decNumberIsSpecial(&b->sum[i]))
+			decNumberCopy(&t, &b->sum[i]);
+		else
+			dn_add(&t, &b->sum[i], &b->comp[i]);
+		if (i < 4)
+			packed128_from_number(wide[i], &t);
+		else
+			packed_from_number(narrow[i - 4], &t);
+	}
+	sigmaN = b->n;
+	return 0;
+}
+#endif
+
 /* Loop through the various modes and work out
  * which has the highest absolute correlation.
  */
@@ -760,6 +903,105 @@ void stats_sto_random(enum nilop op) {
 	taus_seed(s);
 }
 
+#ifdef BULK_RANDOM
+static decNumber *random_uniform(decNumber *r) {
+	decNumber z;
+
+	ullint_to_dn(&z, taus_get());
+	return dn_multiply(r, &z, &const_randfac);
+}
+
+/* Fill n packed reals with random numbers, one RAN# worth of the generator
+ * for each uniform.  Normals use the Box-Muller transform, two for each
+ * pair of uniforms, and exponentials (unit mean) the inverse of the CDF.
+ */
+void stats_random_fill(decimal64 *x, int n, int kind) {
+	decNumber u, v, r, s, c;
+	int i;
+
+	if (RandS1 == 0 && RandS2 == 0 && RandS3 == 0)
+		taus_seed(0);
+	for (i = 0; i < n; i++) {
+		random_uniform(&u);
+		if (kind != RANDOM_UNIFORM) {
+			dn_1m(&v, &u);
+			dn_ln(&r, &v);
+			dn_minus(&u, &r);
+			if (kind == RANDOM_NORMAL) {
+				dn_mul2(&v, &u);
+				dn_sqrt(&r, &v);
+				random_uniform(&u);
+				dn_multiply(&v, &u, &const_2PI);
+				dn_sincos(&v, &s, &c);
+				dn_multiply(&u, &r, &c);
+				if (i + 1 < n) {
+					packed_from_number(x + i++, &u);
+					dn_multiply(&u, &r, &s);
+				}
+			}
+		}
+		packed_from_number(x + i, &u);
+	}
+}
+
+/* Apply a step matrix of one component, held as the images of the unit
+ * vectors, to a state.
+ */
+static unsigned long int taus_apply(const unsigned long int m[32], unsigned long int s) {
+	unsigned long int r = 0;
+	int j;
+
+	for (j = 0; s != 0; j++, s >>= 1)
+		if (s & 1)
+			r ^= m[j];
+	return r;
+}
+
+static void taus_compose(unsigned long int r[32], const unsigned long int a[32], const unsigned long int b[32]) {
+	unsigned long int t[32];
+	int j;
+
+	for (j = 0; j < 32; j++)
+		t[j] = taus_apply(a, b[j]);
+	xcopy(r, t, sizeof(t));
+}
+
+/* Advance the generator by n * 2^shift steps.  Each component of the
+ * generator is linear over GF(2), so this raises its 32 by 32 bit step
+ * matrix to that power instead of stepping.
+ */
+void stats_random_jump(unsigned long long int n, int shift) {
+	static const unsigned char abd[3][3] = { { 13, 19, 12 }, { 2, 25, 4 }, { 3, 11, 17 } };
+	static const unsigned long int c[3] = { 4294967294UL, 4294967288UL, 4294967280UL };
+	unsigned long int s[3], m[32], p[32];
+	unsigned long long int q;
+	int i, j;
+
+	if (RandS1 == 0 && RandS2 == 0 && RandS3 == 0)
+		taus_seed(0);
+	s[0] = RandS1;
+	s[1] = RandS2;
+	s[2] = RandS3;
+	for (i = 0; i < 3; i++) {
+		for (j = 0; j < 32; j++) {
+			m[j] = TAUSWORTHE(1UL << j, abd[i][0], abd[i][1], c[i], abd[i][2]);
+			p[j] = 1UL << j;
+		}
+		for (j = 0; j < shift; j++)
+			taus_compose(m, m, m);
+		for (q = n; q != 0; q >>= 1) {
+			if (q & 1)
+				taus_compose(p, m, p);
+			taus_compose(m, m, m);
+		}
+		s[i] = taus_apply(p, s[i]);
+	}
+	RandS1 = s[0];
+	RandS2 = s[1];
+	RandS3 = s[2];
+}
+#endif
+
 static void check_low(decNumber *d) {
 	if (dn_abs_lt(d, &const_1e_32))
 		decNumberCopy(d, &const_1e_32);
@@ -869,3 +1111,1055 @@ decNumber *betai(decNumber *r, const decNumber *b, const decNumber *a, const dec
 	}
 }
 
+
+#ifdef NATIVE_DISTRIBUTIONS
+/*
+ *  Native versions of the distribution functions that are XROM programs on
+ *  the calculator.  The parameters live in J and K just as they do there.
+ *
+ *  The quantiles start from an estimate and take higher order Newton steps
+ *  on the smaller tail, or far from the root on its logarithm which copes
+ *  with the power law tails of the t and F distributions.  A step that would leave the bracket found so
+ *  far is replaced by a bisection.
+ */
+#define PARAM_ANY	0
+#define PARAM_NOTNEG	1
+#define PARAM_POS	2
+
+typedef struct _distribution {
+	decNumber *(*tail)(decNumber *, const decNumber *, int, const struct _distribution *);
+	decNumber *(*pdf)(decNumber *, const decNumber *, const struct _distribution *);
+	decNumber *(*slope)(decNumber *, decNumber *, const decNumber *, const struct _distribution *);
+	decNumber j, k;
+	decNumber lnc;		// log of the pdf's constant factor, set by the quantile
+} DISTRIBUTION;
+
+static int dist_param(decNumber *r, int index, int check) {
+	getRegister(r, index);
+	if (decNumberIsSpecial(r) || (check == PARAM_POS && dn_le0(r))
+			|| (check == PARAM_NOTNEG && dn_lt0(r)))
+		return report_err(ERR_BAD_PARAM);
+	return 0;
+}
+
+/* Quantiles return NaN rather than an error for these
+ */
+static int bad_probability(const decNumber *p) {
+	return decNumberIsNaN(p) || dn_lt0(p) || dn_gt(p, &const_1);
+}
+
+/* Far from the root Newton's step u = -h / h' is taken on h = ln(tail / q),
+ * which is much closer to linear in the tails.  The slope s of the log pdf
+ * gives h'' = h' (s - h') and turns it into Halley's step
+ * u / (1 + u (s - h') / 2).  Near the root h = tail - q saves the logarithm
+ * and with the derivative s' of the slope the inverse series is taken up
+ * to u^3, as the XROM code does for the normal quantile.
+ *
+ * e = |u| sqrt((s - h')^2 + |s'|) measures how far from linear h is over
+ * the step, the error left after it is about |u| e, |u| e^2 or |u| e^3.
+ * The search stops as soon as that is below register precision instead of
+ * waiting for a step that small.
+ */
+static decNumber *qf_search(decNumber *x, const decNumber *p, const DISTRIBUTION *d, int nonneg) {
+	decNumber q, c, f, lo, hi, s, ds, t, u, w, e;
+	const int upper = dn_gt(p, &const_0_5);
+	const int digits = is_dblmode() ? 34 : 16;
+	int i, bisect, near;
+
+	if (upper)
+		dn_1m(&q, p);
+	else
+		decNumberCopy(&q, p);
+	if (nonneg)
+		decNumberZero(&lo);
+	else
+		set_neginf(&lo);
+	set_inf(&hi);
+
+	for (i = 0; i < 100; i++) {
+		(*d->tail)(&c, x, upper, d);
+		if (dn_eq(&c, &q))
+			return x;
+		if (dn_gt(&c, &q) ? ! upper : upper)
+			decNumberCopy(&hi, x);
+		else
+			decNumberCopy(&lo, x);
+
+		(*d->pdf)(&f, x, d);
+		bisect = 1;
+		if (! dn_eq0(&c) && ! dn_eq0(&f) && ! decNumberIsSpecial(&c) && ! decNumberIsSpecial(&f)) {
+			dn_subtract(&t, &c, &q);
+			dn_div2(&w, &q);
+			near = dn_abs_lt(&t, &w);
+			if (near) {
+				dn_divide(&u, &t, &f);
+				decNumberZero(&w);
+			} else {
+				dn_divide(&t, &c, &q);
+				dn_ln(&u, &t);
+				dn_multiply(&t, &u, &c);
+				dn_divide(&u, &t, &f);
+				dn_divide(&w, &f, &c);	// h'
+			}
+			if (upper)
+				dn_minus(&w, &w);
+			else
+				dn_minus(&u, &u);
+			(*d->slope)(&s, &ds, x, d);
+			dn_subtract(&w, &s, &w);
+			dn_multiply(&f, &w, &u);
+			dn_div2(&t, &f);			// u (s - h') / 2
+			decNumberSquare(&w, &f);
+			decNumberSquare(&f, &u);
+			dn_abs(&e, &ds);
+			dn_multiply(&e, &e, &f);
+			dn_add(&f, &w, &e);
+			dn_sqrt(&w, &f);			// e
+			dn_abs(&e, &u);
+			dn_multiply(&e, &e, &w);
+			if (dn_abs_lt(&t, &const_0_5)) {
+				dn_multiply(&e, &e, &w);
+				if (near) {
+					/* u (1 - u s / 2 + u^2 (s^2 / 3 - s' / 6)) */
+					dn_multiply(&e, &e, &w);
+					decNumberSquare(&f, &s);
+					dn_divide(&w, &f, &const_3);
+					dn_divide(&f, &ds, &const_6);
+					dn_subtract(&s, &w, &f);
+					decNumberSquare(&f, &u);
+					dn_multiply(&w, &s, &f);
+					dn_subtract(&f, &w, &t);
+					dn_p1(&w, &f);
+					dn_multiply(&u, &u, &w);
+				} else {
+					dn_p1(&t, &t);
+					dn_divide(&u, &u, &t);
+				}
+			}
+			/* Steps larger than x itself are taken in log x */
+			dn_abs(&t, &u);
+			if (dn_abs_lt(x, &t) && (nonneg || ! dn_abs_lt(x, &const_1))) {
+				dn_divide(&t, &u, x);
+				dn_exp(&u, &t);
+				dn_multiply(&t, x, &u);
+				set_inf(&e);
+			} else
+				dn_add(&t, x, &u);
+			bisect = ! dn_gt(&t, &lo) || ! dn_lt(&t, &hi);
+		}
+		if (bisect) {
+			if (decNumberIsInfinite(&hi)) {
+				dn_abs(&u, &lo);
+				dn_add(&t, &lo, dn_p1(&u, &u));
+			} else if (decNumberIsInfinite(&lo)) {
+				dn_abs(&u, &hi);
+				dn_subtract(&t, &hi, dn_p1(&u, &u));
+			} else
+				dn_average(&t, &lo, &hi);
+		}
+		dn_subtract(&u, &t, x);
+		decNumberCopy(x, &t);
+		if (decNumberIsSpecial(x))
+			break;
+		if (bisect)
+			dn_abs(&e, &u);
+		dn_mulpow10(&f, x, -digits - 1);
+		if (dn_abs_lt(&e, dn_abs(&f, &f)) || dn_eq0(&u))
+			return x;
+		busy();
+	}
+	report_err(ERR_SOLVE);
+	return NULL;
+}
+
+/* The smallest integer k with a cumulative probability of at least p.
+ * A bracket is grown from the estimate and then bisected.
+ */
+static decNumber *qf_discrete(decNumber *r, const decNumber *p, const decNumber *est, const DISTRIBUTION *d) {
+	decNumber lo, hi, step, c, t;
+	int i;
+
+	decNumberFloor(&t, est);
+	if (decNumberIsSpecial(&t) || dn_lt0(&t))
+		decNumberZero(&t);
+	dn_1(&step);
+	(*d->tail)(&c, &t, 0, d);
+	if (dn_lt(&c, p)) {
+		decNumberCopy(&lo, &t);
+		for (i = 0;; i++) {
+			dn_add(&hi, &lo, &step);
+			if (dn_ge((*d->tail)(&c, &hi, 0, d), p))
+				break;
+			if (i == 1000 || decNumberIsNaN(&c))
+				goto fail;
+			decNumberCopy(&lo, &hi);
+			dn_mul2(&step, &step);
+		}
+	} else {
+		decNumberCopy(&hi, &t);
+		for (;;) {
+			dn_subtract(&lo, &hi, &step);
+			if (dn_lt0(&lo)) {
+				dn__1(&lo);
+				break;
+			}
+			if (dn_lt((*d->tail)(&c, &lo, 0, d), p))
+				break;
+			decNumberCopy(&hi, &lo);
+			dn_mul2(&step, &step);
+		}
+	}
+	for (;;) {
+		dn_subtract(&t, &hi, &lo);
+		if (! dn_gt(&t, &const_1))
+			return decNumberCopy(r, &hi);
+		dn_average(&t, &lo, &hi);
+		decNumberFloor(&t, &t);
+		if (dn_ge((*d->tail)(&c, &t, 0, d), p))
+			decNumberCopy(&hi, &t);
+		else
+			decNumberCopy(&lo, &t);
+		busy();
+	}
+fail:
+	report_err(ERR_SOLVE);
+	return NULL;
+}
+
+/* Standard normal distribution
+ */
+decNumber *pdf_Q(decNumber *r, const decNumber *x) {
+	decNumber t;
+
+	decNumberSquare(&t, x);
+	dn_div2(&t, &t);
+	dn_minus(&t, &t);
+	dn_exp(&t, &t);
+	return dn_multiply(r, &t, &const_recipsqrt2PI);
+}
+
+static decNumber *tail_Q(decNumber *r, const decNumber *x, int upper, const DISTRIBUTION *d) {
+	decNumber s, t;
+
+	if (upper)
+		dn_minus(&s, x);
+	else
+		decNumberCopy(&s, x);
+	if (decNumberIsInfinite(&s))
+		return decNumberIsNegative(&s) ? decNumberZero(r) : dn_1(r);
+	decNumberSquare(&t, &s);
+	dn_div2(&t, &t);
+	if (decNumberIsNegative(&s)) {
+		dn_gammainc(&s, &t, &const_0_5, 1, 1);
+		return dn_div2(r, &s);
+	}
+	dn_gammainc(&s, &t, &const_0_5, 1, 0);
+	return dn_div2(r, dn_p1(&t, &s));
+}
+
+static decNumber *dist_pdf_Q(decNumber *r, const decNumber *x, const DISTRIBUTION *d) {
+	return pdf_Q(r, x);
+}
+
+/* Dieter's estimate of the normal quantile, as used by the XROM code
+ */
+static decNumber *qf_Q_est(decNumber *r, const decNumber *p) {
+	decNumber q, t, u, v;
+
+	dn_1m(&q, p);
+	if (dn_lt(p, &q))
+		decNumberCopy(&q, p);
+	if (dn_lt(&q, &const_0_2)) {
+		dn_ln(&t, &q);
+		dn_mul2(&t, &t);
+		dn_minus(&u, &t);			// u = -2 ln q
+		dn_m1(&t, &u);
+		dn_multiply(&v, &t, &const_2PI);
+		dn_sqrt(&t, &v);
+		dn_multiply(&v, &t, &q);
+		dn_ln(&t, &v);
+		dn_mul2(&t, &t);
+		dn_minus(&t, &t);
+		dn_sqrt(&v, &t);
+		int_to_dn(&t, 264);
+		dn_mulpow10(&t, &t, -3);
+		dn_divide(&t, &t, &u);
+		dn_add(r, &v, &t);
+	} else {
+		dn_subtract(&t, &const_0_5, &q);
+		dn_multiply(&u, &t, &const_sqrt2PI);
+		decNumberCube(&t, &u);
+		dn_divide(&v, &t, &const_5);
+		dn_add(r, &u, &v);
+	}
+	if (dn_lt(p, &const_0_5))
+		dn_minus(r, r);
+	return r;
+}
+
+static decNumber *slope_Q(decNumber *r, decNumber *dr, const decNumber *x, const DISTRIBUTION *d) {
+	dn_minus(dr, &const_1);
+	return dn_minus(r, x);
+}
+
+static const DISTRIBUTION dist_Q = { &tail_Q, &dist_pdf_Q, &slope_Q };
+
+static decNumber *dist_CDF_Q(decNumber *r, const decNumber *x) {
+	return tail_Q(r, x, 0, NULL);
+}
+
+static decNumber *dist_CDFU_Q(decNumber *r, const decNumber *x) {
+	return tail_Q(r, x, 1, NULL);
+}
+
+static decNumber *dist_QF_Q(decNumber *r, const decNumber *p) {
+	if (bad_probability(p))
+		return set_NaN(r);
+	if (dn_eq0(p))
+		return set_neginf(r);
+	if (dn_eq1(p))
+		return set_inf(r);
+	if (dn_eq(p, &const_0_5))
+		return decNumberZero(r);
+	qf_Q_est(r, p);
+	return qf_search(r, p, &dist_Q, 0);
+}
+
+/* Normal and log normal distributions
+ * J = mean, K = standard deviation
+ */
+static int normal_param(DISTRIBUTION *d) {
+	return dist_param(&d->j, regJ_idx, PARAM_ANY) || dist_param(&d->k, regK_idx, PARAM_POS);
+}
+
+static decNumber *tail_normal(decNumber *r, const decNumber *x, int upper) {
+	DISTRIBUTION d;
+	decNumber t, u;
+
+	if (normal_param(&d))
+		return NULL;
+	dn_subtract(&t, x, &d.j);
+	dn_divide(&u, &t, &d.k);
+	return tail_Q(r, &u, upper, NULL);
+}
+
+static decNumber *dist_CDF_NORMAL(decNumber *r, const decNumber *x) {
+	return tail_normal(r, x, 0);
+}
+
+static decNumber *dist_CDFU_NORMAL(decNumber *r, const decNumber *x) {
+	return tail_normal(r, x, 1);
+}
+
+static decNumber *dist_QF_NORMAL(decNumber *r, const decNumber *p) {
+	DISTRIBUTION d;
+	decNumber t;
+
+	if (normal_param(&d) || dist_QF_Q(&t, p) == NULL)
+		return NULL;
+	dn_multiply(r, &t, &d.k);
+	return dn_add(r, r, &d.j);
+}
+
+static decNumber *tail_lognormal(decNumber *r, const decNumber *x, int upper) {
+	decNumber t;
+
+	if (decNumberIsNaN(x))
+		return set_NaN(r);
+	if (dn_le0(x)) {
+		DISTRIBUTION d;
+
+		if (normal_param(&d))
+			return NULL;
+		return upper ? dn_1(r) : decNumberZero(r);
+	}
+	return tail_normal(r, dn_ln(&t, x), upper);
+}
+
+static decNumber *dist_CDF_LOGNORMAL(decNumber *r, const decNumber *x) {
+	return tail_lognormal(r, x, 0);
+}
+
+static decNumber *dist_CDFU_LOGNORMAL(decNumber *r, const decNumber *x) {
+	return tail_lognormal(r, x, 1);
+}
+
+static decNumber *dist_QF_LOGNORMAL(decNumber *r, const decNumber *p) {
+	decNumber t;
+
+	if (dist_QF_NORMAL(&t, p) == NULL)
+		return NULL;
+	return dn_exp(r, &t);
+}
+
+/* Chi-squared distribution
+ * J = degrees of freedom (non-negative integer)
+ */
+static int chi2_param(DISTRIBUTION *d) {
+	if (dist_param(&d->j, regJ_idx, PARAM_NOTNEG))
+		return 1;
+	if (! is_int(&d->j))
+		return report_err(ERR_BAD_PARAM);
+	return 0;
+}
+
+static decNumber *tail_chi2(decNumber *r, const decNumber *x, int upper, const DISTRIBUTION *d) {
+	decNumber a, t;
+
+	if (decNumberIsNaN(x))
+		return set_NaN(r);
+	if (dn_le0(x))
+		return upper ? dn_1(r) : decNumberZero(r);
+	if (decNumberIsInfinite(x))
+		return upper ? decNumberZero(r) : dn_1(r);
+	dn_div2(&t, x);
+	dn_div2(&a, &d->j);
+	return dn_gammainc(r, &t, &a, 1, upper);
+}
+
+/* lnc = -(k/2 ln 2 + ln Gamma(k/2))
+ */
+static decNumber *pdf_chi2(decNumber *r, const decNumber *x, const DISTRIBUTION *d) {
+	decNumber a, t, u, v;
+
+	if (dn_le0(x))
+		return decNumberZero(r);
+	dn_div2(&a, &d->j);
+	dn_ln(&t, x);
+	dn_m1(&u, &a);
+	dn_multiply(&v, &t, &u);		// (k/2 - 1) ln x
+	dn_div2(&t, x);
+	dn_subtract(&u, &v, &t);
+	dn_add(&v, &u, &d->lnc);
+	return dn_exp(r, &v);
+}
+
+static decNumber *slope_chi2(decNumber *r, decNumber *dr, const decNumber *x, const DISTRIBUTION *d) {
+	decNumber t, u;
+
+	dn_div2(&t, &d->j);
+	dn_m1(&u, &t);
+	dn_divide(&t, &u, x);			// (k / 2 - 1) / x
+	dn_divide(&u, &t, x);
+	dn_minus(dr, &u);
+	return dn_subtract(r, &t, &const_0_5);
+}
+
+static decNumber *tail_chi2_param(decNumber *r, const decNumber *x, int upper) {
+	DISTRIBUTION d;
+
+	if (chi2_param(&d))
+		return NULL;
+	return tail_chi2(r, x, upper, &d);
+}
+
+static decNumber *dist_CDF_CHI2(decNumber *r, const decNumber *x) {
+	return tail_chi2_param(r, x, 0);
+}
+
+static decNumber *dist_CDFU_CHI2(decNumber *r, const decNumber *x) {
+	return tail_chi2_param(r, x, 1);
+}
+
+static decNumber *dist_QF_CHI2(decNumber *r, const decNumber *p) {
+	DISTRIBUTION d = { &tail_chi2, &pdf_chi2, &slope_chi2 };
+	decNumber a, h, t, u, v;
+
+	if (chi2_param(&d))
+		return NULL;
+	if (bad_probability(p))
+		return set_NaN(r);
+	if (dn_eq0(p))
+		return decNumberZero(r);
+	if (dn_eq1(p))
+		return set_inf(r);
+
+	/* P(k/2, x/2) <= (x/2)^(k/2) / (k/2)!, so this is a lower bound */
+	dn_div2(&a, &d.j);
+	dn_p1(&t, &a);
+	decNumberLnGamma(&u, &t);
+	dn_ln(&t, p);
+	dn_add(&v, &t, &u);
+	dn_divide(&t, &v, &a);
+	dn_exp(&t, &t);
+	dn_mul2(r, &t);
+
+	dn_ln(&t, &a);
+	dn_subtract(&v, &u, &t);		// ln Gamma(k/2)
+	dn_multiply(&t, &a, &const_ln2);
+	dn_add(&u, &v, &t);
+	dn_minus(&d.lnc, &u);
+
+	/* Wilson and Hilferty */
+	dn_multiply(&t, &d.j, &const_9);
+	dn_divide(&h, &const_2, &t);
+	qf_Q_est(&t, p);
+	dn_sqrt(&u, &h);
+	dn_multiply(&v, &t, &u);
+	dn_1m(&t, &h);
+	dn_add(&u, &t, &v);
+	decNumberCube(&t, &u);
+	dn_multiply(&u, &t, &d.j);
+	if (dn_gt(&u, r))
+		decNumberCopy(r, &u);
+	return qf_search(r, p, &d, 1);
+}
+
+/* Student's t distribution
+ * J = degrees of freedom (real > 0), infinite for the standard normal
+ */
+static int t_param(DISTRIBUTION *d, int *normal) {
+	getRegister(&d->j, regJ_idx);
+	*normal = decNumberIsInfinite(&d->j) && ! decNumberIsNegative(&d->j);
+	if (*normal)
+		return 0;
+	return dist_param(&d->j, regJ_idx, PARAM_POS);
+}
+
+static decNumber *tail_T(decNumber *r, const decNumber *x, int upper, const DISTRIBUTION *d) {
+	decNumber s, t, u, v, w;
+	int neg;
+
+	if (decNumberIsNaN(x))
+		return set_NaN(r);
+	if (upper)
+		dn_minus(&s, x);
+	else
+		decNumberCopy(&s, x);
+	neg = decNumberIsNegative(&s);
+	if (decNumberIsInfinite(&s))
+		return neg ? decNumberZero(r) : dn_1(r);
+	if (dn_eq0(&s))
+		return decNumberCopy(r, &const_0_5);
+
+	decNumberSquare(&t, &s);
+	dn_add(&u, &t, &d->j);
+	dn_div2(&v, &d->j);
+	if (dn_lt(&t, &const_1)) {
+		dn_divide(&w, &t, &u);
+		betai(&t, &v, &const_0_5, &w);
+		dn_div2(&u, &t);
+		if (neg)
+			return dn_subtract(r, &const_0_5, &u);
+		return dn_add(r, &const_0_5, &u);
+	}
+	dn_divide(&w, &d->j, &u);
+	betai(&t, &const_0_5, &v, &w);
+	dn_div2(&u, &t);
+	if (neg)
+		return decNumberCopy(r, &u);
+	return dn_1m(r, &u);
+}
+
+/* lnc = ln Gamma((v + 1) / 2) - ln Gamma(v / 2) - ln(pi v) / 2
+ */
+static decNumber *pdf_T(decNumber *r, const decNumber *x, const DISTRIBUTION *d) {
+	decNumber a, t, u;
+
+	dn_p1(&t, &d->j);
+	dn_div2(&a, &t);			// a = (v + 1) / 2
+	decNumberSquare(&t, x);
+	dn_divide(&u, &t, &d->j);
+	decNumberLn1p(&t, &u);
+	dn_multiply(&u, &t, &a);
+	dn_subtract(&t, &d->lnc, &u);
+	return dn_exp(r, &t);
+}
+
+static decNumber *slope_T(decNumber *r, decNumber *dr, const decNumber *x, const DISTRIBUTION *d) {
+	decNumber s, t, u;
+
+	decNumberSquare(&s, x);
+	dn_add(&u, &s, &d->j);			// v + x^2
+	dn_subtract(&t, &d->j, &s);
+	dn_p1(&s, &d->j);
+	dn_multiply(dr, &t, &s);
+	decNumberSquare(&t, &u);
+	dn_divide(dr, dr, &t);
+	dn_minus(dr, dr);
+	dn_multiply(r, &s, x);
+	dn_divide(&t, r, &u);
+	return dn_minus(r, &t);
+}
+
+static decNumber *tail_T_param(decNumber *r, const decNumber *x, int upper) {
+	DISTRIBUTION d;
+	int normal;
+
+	if (t_param(&d, &normal))
+		return NULL;
+	if (normal)
+		return tail_Q(r, x, upper, NULL);
+	return tail_T(r, x, upper, &d);
+}
+
+static decNumber *dist_CDF_T(decNumber *r, const decNumber *x) {
+	return tail_T_param(r, x, 0);
+}
+
+static decNumber *dist_CDFU_T(decNumber *r, const decNumber *x) {
+	return tail_T_param(r, x, 1);
+}
+
+static decNumber *dist_QF_T(decNumber *r, const decNumber *p) {
+	DISTRIBUTION d = { &tail_T, &pdf_T, &slope_T };
+	decNumber q, z, t, u, v, w;
+	int normal;
+
+	if (t_param(&d, &normal))
+		return NULL;
+	if (normal)
+		return dist_QF_Q(r, p);
+	if (bad_probability(p))
+		return set_NaN(r);
+	if (dn_eq0(p))
+		return set_neginf(r);
+	if (dn_eq1(p))
+		return set_inf(r);
+	if (dn_eq(p, &const_0_5))
+		return decNumberZero(r);
+
+	/* Cornish-Fisher expansion about the normal quantile */
+	qf_Q_est(&z, p);
+	dn_abs(&z, &z);
+	decNumberSquare(&t, &z);
+	dn_p1(&u, &t);
+	dn_multiply(&v, &u, &z);
+	dn_multiply(&u, &d.j, &const_4);
+	dn_divide(&w, &v, &u);			// (z^3 + z) / 4v
+	dn_multiply(&u, &t, &const_5);
+	dn_add(&u, &u, &const_16);
+	dn_multiply(&v, &u, &t);
+	dn_add(&u, &v, &const_3);
+	dn_multiply(&v, &u, &z);		// 5z^5 + 16z^3 + 3z
+	decNumberSquare(&u, &d.j);
+	dn_multiply(&t, &u, &const_32);
+	dn_multiply(&u, &t, &const_3);
+	dn_divide(&t, &v, &u);
+	dn_add(&u, &w, &t);
+	dn_add(r, &z, &u);
+
+	/* The tail is at most c v^((v-1)/2) / t^v, an upper bound */
+	dn_1m(&q, p);
+	if (dn_lt(p, &q))
+		decNumberCopy(&q, p);
+	dn_div2(&t, &d.j);
+	decNumberLnGamma(&u, &t);
+	dn_add(&t, &t, &const_0_5);
+	decNumberLnGamma(&v, &t);
+	dn_subtract(&w, &v, &u);		// ln(G((v+1)/2) / G(v/2))
+	dn_mulPI(&t, &d.j);
+	dn_ln(&u, &t);
+	dn_div2(&u, &u);
+	dn_subtract(&v, &w, &u);		// ln c
+	decNumberCopy(&d.lnc, &v);
+	dn_m1(&t, &d.j);
+	dn_div2(&t, &t);
+	dn_ln(&u, &d.j);
+	dn_multiply(&w, &t, &u);
+	dn_add(&t, &v, &w);
+	dn_ln(&u, &q);
+	dn_subtract(&v, &t, &u);
+	dn_divide(&t, &v, &d.j);
+	dn_exp(&u, &t);
+	if (dn_lt(&u, r))
+		decNumberCopy(r, &u);
+
+	if (dn_lt(p, &const_0_5))
+		dn_minus(r, r);
+	return qf_search(r, p, &d, 0);
+}
+
+/* F distribution
+ * J = df1 (real > 0), K = df2 (real > 0)
+ */
+static int f_param(DISTRIBUTION *d) {
+	return dist_param(&d->j, regJ_idx, PARAM_POS) || dist_param(&d->k, regK_idx, PARAM_POS);
+}
+
+static decNumber *tail_F(decNumber *r, const decNumber *x, int upper, const DISTRIBUTION *d) {
+	decNumber a, b, t, u, w;
+
+	if (decNumberIsNaN(x))
+		return set_NaN(r);
+	if (dn_le0(x))
+		return upper ? dn_1(r) : decNumberZero(r);
+	if (decNumberIsInfinite(x))
+		return upper ? decNumberZero(r) : dn_1(r);
+	dn_multiply(&t, x, &d->j);
+	dn_add(&u, &t, &d->k);
+	dn_div2(&a, &d->j);
+	dn_div2(&b, &d->k);
+	if (upper) {
+		dn_divide(&w, &d->k, &u);
+		return betai(r, &a, &b, &w);
+	}
+	dn_divide(&w, &t, &u);
+	return betai(r, &b, &a, &w);
+}
+
+/* lnc = (d1 ln d1 + d2 ln d2) / 2 - ln B(d1 / 2, d2 / 2)
+ */
+static decNumber *pdf_F(decNumber *r, const decNumber *x, const DISTRIBUTION *d) {
+	decNumber s, t, u, v;
+
+	if (dn_le0(x))
+		return decNumberZero(r);
+	dn_ln(&t, x);
+	dn_multiply(&s, &t, &d->j);		// d1 ln x
+	dn_multiply(&u, x, &d->j);
+	dn_add(&t, &u, &d->k);
+	dn_ln(&u, &t);
+	dn_add(&t, &d->j, &d->k);
+	dn_multiply(&v, &u, &t);
+	dn_subtract(&t, &s, &v);		// - (d1 + d2) ln(x d1 + d2)
+	dn_div2(&s, &t);
+	dn_add(&u, &s, &d->lnc);
+	dn_exp(&t, &u);
+	return dn_divide(r, &t, x);
+}
+
+static decNumber *slope_F(decNumber *r, decNumber *dr, const decNumber *x, const DISTRIBUTION *d) {
+	decNumber s, t, u, v;
+
+	dn_multiply(&t, x, &d->j);
+	dn_add(&u, &t, &d->k);
+	dn_add(&t, &d->j, &d->k);
+	dn_multiply(&s, &t, &d->j);
+	dn_divide(&t, &s, &u);			// (d1 + d2) d1 / (x d1 + d2)
+	dn_multiply(&s, &t, &d->j);
+	dn_divide(&v, &s, &u);
+	dn_m1(&s, &d->j);
+	dn_m1(&s, &s);
+	dn_divide(&u, &s, x);			// (d1 - 2) / x
+	dn_subtract(&s, &u, &t);
+	dn_div2(r, &s);
+	dn_divide(&s, &u, x);
+	dn_subtract(&t, &v, &s);
+	return dn_div2(dr, &t);
+}
+
+static decNumber *tail_F_param(decNumber *r, const decNumber *x, int upper) {
+	DISTRIBUTION d;
+
+	if (f_param(&d))
+		return NULL;
+	return tail_F(r, x, upper, &d);
+}
+
+static decNumber *dist_CDF_F(decNumber *r, const decNumber *x) {
+	return tail_F_param(r, x, 0);
+}
+
+static decNumber *dist_CDFU_F(decNumber *r, const decNumber *x) {
+	return tail_F_param(r, x, 1);
+}
+
+static decNumber *f_dof(decNumber *r, const decNumber *v) {
+	if (dn_gt(v, &const_1))
+		dn_m1(r, v);
+	else
+		decNumberCopy(r, v);
+	return decNumberRecip(r, r);
+}
+
+static decNumber *dist_QF_F(decNumber *r, const decNumber *p) {
+	DISTRIBUTION d = { &tail_F, &pdf_F, &slope_F };
+	decNumber a, b, h, l, z, t, u, v;
+
+	if (f_param(&d))
+		return NULL;
+	if (bad_probability(p))
+		return set_NaN(r);
+	if (dn_eq0(p))
+		return decNumberZero(r);
+	if (dn_eq1(p))
+		return set_inf(r);
+
+	dn_ln(&t, &d.j);
+	dn_multiply(&u, &t, &d.j);
+	dn_ln(&t, &d.k);
+	dn_multiply(&v, &t, &d.k);
+	dn_add(&t, &u, &v);
+	dn_div2(&h, &t);
+	dn_div2(&a, &d.j);
+	dn_div2(&b, &d.k);
+	decNumberLnBeta(&t, &a, &b);
+	dn_subtract(&d.lnc, &h, &t);
+
+	/* Abramowitz and Stegun 26.6.16, as the XROM code does */
+	f_dof(&a, &d.j);
+	f_dof(&b, &d.k);
+	dn_add(&t, &a, &b);
+	dn_divide(&h, &const_2, &t);
+	qf_Q_est(&z, p);
+	decNumberSquare(&t, &z);
+	dn_subtract(&u, &t, &const_3);
+	dn_divide(&l, &u, &const_6);		// l = (z^2 - 3) / 6
+	dn_add(&t, &h, &l);
+	dn_sqrt(&u, &t);
+	dn_multiply(&t, &u, &z);
+	dn_divide(&v, &t, &h);			// z sqrt(h + l) / h
+	dn_multiply(&t, &h, &const_3);
+	dn_divide(&u, &const_2, &t);
+	dn_subtract(&t, &l, &u);
+	dn_add(&u, &t, &const_5on6);
+	dn_subtract(&t, &a, &b);
+	dn_multiply(&h, &t, &u);
+	dn_subtract(&t, &v, &h);
+	dn_mul2(&u, &t);
+	dn_exp(r, &u);
+	if (decNumberIsSpecial(r) || dn_le0(r))
+		dn_1(r);
+	return qf_search(r, p, &d, 1);
+}
+
+/* Binomial distribution
+ * J = probability, K = n
+ * Returns -1 for an error, 1 if the result is NaN, 2 if it is zero.
+ */
+static int binomial_param(DISTRIBUTION *d) {
+	getRegister(&d->j, regJ_idx);
+	if (decNumberIsNaN(&d->j))
+		return 1;
+	if (dn_lt0(&d->j) || dn_gt(&d->j, &const_1))
+		return -report_err(ERR_BAD_PARAM);
+	if (dist_param(&d->k, regK_idx, PARAM_ANY))
+		return -1;
+	if (! is_int(&d->k) || dn_lt0(&d->k))
+		return 2;
+	return 0;
+}
+
+static decNumber *tail_binomial(decNumber *r, const decNumber *x, int upper, const DISTRIBUTION *d) {
+	decNumber k, t, u;
+
+	if (upper) {
+		decNumberCeil(&k, x);
+		if (dn_le0(&k))
+			return dn_1(r);
+		if (dn_gt(&k, &d->k))
+			return decNumberZero(r);
+		dn_subtract(&t, &d->k, &k);
+		dn_p1(&u, &t);
+		return betai(r, &u, &k, &d->j);
+	}
+	decNumberFloor(&k, x);
+	if (dn_lt0(&k))
+		return decNumberZero(r);
+	if (dn_ge(&k, &d->k))
+		return dn_1(r);
+	dn_subtract(&t, &d->k, &k);
+	dn_p1(&k, &k);
+	dn_1m(&u, &d->j);
+	return betai(r, &k, &t, &u);
+}
+
+static decNumber *dist_binomial(decNumber *r, const decNumber *x, int upper) {
+	DISTRIBUTION d;
+
+	switch (binomial_param(&d)) {
+	case -1:	return NULL;
+	case 1:		return set_NaN(r);
+	case 2:		return decNumberZero(r);
+	}
+	if (decNumberIsNaN(x))
+		return set_NaN(r);
+	return tail_binomial(r, x, upper, &d);
+}
+
+static decNumber *dist_CDF_BINOMIAL(decNumber *r, const decNumber *x) {
+	return dist_binomial(r, x, 0);
+}
+
+static decNumber *dist_CDFU_BINOMIAL(decNumber *r, const decNumber *x) {
+	return dist_binomial(r, x, 1);
+}
+
+/* The normal approximation with a skewness correction
+ */
+static decNumber *discrete_est(decNumber *r, const decNumber *p, const decNumber *mean, const decNumber *sd) {
+	decNumber z, t, u;
+
+	qf_Q_est(&z, p);
+	decNumberSquare(&t, &z);
+	dn_m1(&u, &t);
+	dn_divide(&t, &u, &const_6);
+	dn_multiply(&u, &z, sd);
+	dn_add(&z, &t, &u);
+	return dn_add(r, &z, mean);
+}
+
+static decNumber *dist_QF_BINOMIAL(decNumber *r, const decNumber *p) {
+	DISTRIBUTION d = { &tail_binomial };
+	decNumber m, s, t;
+
+	switch (binomial_param(&d)) {
+	case -1:	return NULL;
+	case 1:		return set_NaN(r);
+	case 2:		return decNumberZero(r);
+	}
+	if (bad_probability(p))
+		return set_NaN(r);
+	if (dn_eq0(p))
+		return decNumberZero(r);
+	if (dn_eq1(p))
+		return decNumberCopy(r, &d.k);
+	dn_multiply(&m, &d.j, &d.k);
+	dn_1m(&t, &d.j);
+	dn_multiply(&s, &t, &m);
+	dn_sqrt(&s, &s);
+	discrete_est(&t, p, &m, &s);
+	if (qf_discrete(r, p, &t, &d) == NULL)
+		return NULL;
+	return dn_min(r, r, &d.k);
+}
+
+/* Poisson distributions
+ * J = lambda or J = probability and K = n
+ * Returns as binomial_param().
+ */
+static int poisson_param(DISTRIBUTION *d, int two) {
+	getRegister(&d->j, regJ_idx);
+	if (decNumberIsNaN(&d->j))
+		return 1;
+	if (two) {
+		if (dn_lt0(&d->j) || dn_gt(&d->j, &const_1))
+			return -report_err(ERR_BAD_PARAM);
+		getRegister(&d->k, regK_idx);
+		dn_multiply(&d->j, &d->j, &d->k);
+		if (decNumberIsNaN(&d->j))
+			return 1;
+	}
+	if (decNumberIsInfinite(&d->j))
+		return -report_err(ERR_BAD_PARAM);
+	if (dn_le0(&d->j))
+		return 2;
+	return 0;
+}
+
+static decNumber *tail_poisson(decNumber *r, const decNumber *x, int upper, const DISTRIBUTION *d) {
+	decNumber k;
+
+	if (upper) {
+		decNumberCeil(&k, x);
+		if (dn_lt(&k, &const_1))
+			return dn_1(r);
+		if (decNumberIsInfinite(&k))
+			return decNumberZero(r);
+		return dn_gammainc(r, &d->j, &k, 1, 0);
+	}
+	decNumberFloor(&k, x);
+	if (dn_lt0(&k))
+		return decNumberZero(r);
+	if (decNumberIsInfinite(&k))
+		return dn_1(r);
+	dn_p1(&k, &k);
+	return dn_gammainc(r, &d->j, &k, 1, 1);
+}
+
+static decNumber *dist_poisson(decNumber *r, const decNumber *x, int two, int upper) {
+	DISTRIBUTION d;
+
+	switch (poisson_param(&d, two)) {
+	case -1:	return NULL;
+	case 1:		return set_NaN(r);
+	case 2:		return decNumberZero(r);
+	}
+	if (decNumberIsNaN(x))
+		return set_NaN(r);
+	return tail_poisson(r, x, upper, &d);
+}
+
+static decNumber *qf_poisson_common(decNumber *r, const decNumber *p, int two) {
+	DISTRIBUTION d = { &tail_poisson };
+	decNumber s, t;
+
+	switch (poisson_param(&d, two)) {
+	case -1:	return NULL;
+	case 1:		return set_NaN(r);
+	case 2:		return decNumberZero(r);
+	}
+	if (bad_probability(p))
+		return set_NaN(r);
+	if (dn_eq1(p))
+		return set_inf(r);
+	dn_sqrt(&s, &d.j);
+	discrete_est(&t, p, &d.j, &s);
+	return qf_discrete(r, p, &t, &d);
+}
+
+static decNumber *dist_CDF_POISSON(decNumber *r, const decNumber *x) {
+	return dist_poisson(r, x, 0, 0);
+}
+
+static decNumber *dist_CDFU_POISSON(decNumber *r, const decNumber *x) {
+	return dist_poisson(r, x, 0, 1);
+}
+
+static decNumber *dist_QF_POISSON(decNumber *r, const decNumber *p) {
+	return qf_poisson_common(r, p, 0);
+}
+
+static decNumber *dist_CDF_POIS2(decNumber *r, const decNumber *x) {
+	return dist_poisson(r, x, 1, 0);
+}
+
+static decNumber *dist_CDFU_POIS2(decNumber *r, const decNumber *x) {
+	return dist_poisson(r, x, 1, 1);
+}
+
+static decNumber *dist_QF_POIS2(decNumber *r, const decNumber *p) {
+	return qf_poisson_common(r, p, 1);
+}
+
+/* The commands.  Their results are rounded to register precision here so
+ * that setRegister() normalises the rounded value and drops the trailing
+ * zeros rounding leaves.  The functions above call each other unrounded.
+ */
+static decNumber *dist_result(decNumber *r) {
+	REGISTER t;
+
+	if (r == NULL || decNumberIsSpecial(r))
+		return r;
+	if (is_dblmode()) {
+		packed128_from_number(&t.d, r);
+		return decimal128ToNumber(&t.d, r);
+	}
+	packed_from_number(&t.s, r);
+	return decimal64ToNumber(&t.s, r);
+}
+
+#define DIST_COMMAND(name) \
+	decNumber *native_ ## name(decNumber *r, const decNumber *x) { \
+		return dist_result(dist_ ## name(r, x)); \
+	}
+
+DIST_COMMAND(CDF_Q)
+DIST_COMMAND(CDFU_Q)
+DIST_COMMAND(QF_Q)
+DIST_COMMAND(CDF_NORMAL)
+DIST_COMMAND(CDFU_NORMAL)
+DIST_COMMAND(QF_NORMAL)
+DIST_COMMAND(CDF_LOGNORMAL)
+DIST_COMMAND(CDFU_LOGNORMAL)
+DIST_COMMAND(QF_LOGNORMAL)
+DIST_COMMAND(CDF_CHI2)
+DIST_COMMAND(CDFU_CHI2)
+DIST_COMMAND(QF_CHI2)
+DIST_COMMAND(CDF_T)
+DIST_COMMAND(CDFU_T)
+DIST_COMMAND(QF_T)
+DIST_COMMAND(CDF_F)
+DIST_COMMAND(CDFU_F)
+DIST_COMMAND(QF_F)
+DIST_COMMAND(CDF_BINOMIAL)
+DIST_COMMAND(CDFU_BINOMIAL)
+DIST_COMMAND(QF_BINOMIAL)
+DIST_COMMAND(CDF_POISSON)
+DIST_COMMAND(CDFU_POISSON)
+DIST_COMMAND(QF_POISSON)
+DIST_COMMAND(CDF_POIS2)
+DIST_COMMAND(CDFU_POIS2)
+DIST_COMMAND(QF_POIS2)
+#endif
@@ -40,7 +40,7 @@ typedef struct _stat_data {
 	signed int sN;		
 } STAT_DATA;
 
-extern STAT_DATA *StatRegs;
+extern INSTANCE STAT_DATA *StatRegs;
 
 extern int  sigmaCheck(void);
 extern void sigmaDeallocate(void);
@@ -50,6 +50,21 @@ extern int sigma_plus_x(const decNumber*);
 extern void sigma_plus(void);
 extern void sigma_minus(void);
 
+#ifdef SIGMA_BULK
+#define SIGMA_BULK_SUMS	13
+
+typedef struct _sigma_bulk {
+	decNumber sum[SIGMA_BULK_SUMS];
+	decNumber comp[SIGMA_BULK_SUMS];
+	decNumber x, lnx, y, lny;	// previous point and its logarithms
+	int n;
+} SIGMA_BULK_DATA;
+
+extern void sigma_bulk_start(SIGMA_BULK_DATA *b);
+extern void sigma_bulk_add(SIGMA_BULK_DATA *b, const decNumber *x, const decNumber *y);
+extern int sigma_bulk_finish(SIGMA_BULK_DATA *b);
+#endif
+
 extern void stats_mean(enum nilop);
 extern void stats_wmean(enum nilop);
 extern void stats_gmean(enum nilop);
@@ -72,8 +87,47 @@ extern void stats_mode(enum nilop op);
 extern void stats_random(enum nilop);
 extern void stats_sto_random(enum nilop);
 
+#ifdef BULK_RANDOM
+#define RANDOM_UNIFORM		0
+#define RANDOM_NORMAL		1
+#define RANDOM_EXPONENTIAL	2
+
+extern void stats_random_fill(decimal64 *x, int n, int kind);
+extern void stats_random_jump(unsigned long long int n, int shift);
+#endif
+
 extern decNumber *betai(decNumber *, const decNumber *, const decNumber *, const decNumber *);
 extern decNumber *pdf_Q(decNumber *q, const decNumber *x);
 extern void cdf_Q_helper(enum nilop op);
 
+#ifdef NATIVE_DISTRIBUTIONS
+extern decNumber *native_CDF_Q(decNumber *r, const decNumber *x);
+extern decNumber *native_CDFU_Q(decNumber *r, const decNumber *x);
+extern decNumber *native_QF_Q(decNumber *r, const decNumber *x);
+extern decNumber *native_CDF_NORMAL(decNumber *r, const decNumber *x);
+extern decNumber *native_CDFU_NORMAL(decNumber *r, const decNumber *x);
+extern decNumber *native_QF_NORMAL(decNumber *r, const decNumber *x);
+extern decNumber *native_CDF_LOGNORMAL(decNumber *r, const decNumber *x);
+extern decNumber *native_CDFU_LOGNORMAL(decNumber *r, const decNumber *x);
+extern decNumber *native_QF_LOGNORMAL(decNumber *r, const decNumber *x);
+extern decNumber *native_CDF_CHI2(decNumber *r, const decNumber *x);
+extern decNumber *native_CDFU_CHI2(decNumber *r, const decNumber *x);
+extern decNumber *native_QF_CHI2(decNumber *r, const decNumber *x);
+extern decNumber *native_CDF_T(decNumber *r, const decNumber *x);
+extern decNumber *native_CDFU_T(decNumber *r, const decNumber *x);
+extern decNumber *native_QF_T(decNumber *r, const decNumber *x);
+extern decNumber *native_CDF_F(decNumber *r, const decNumber *x);
+extern decNumber *native_CDFU_F(decNumber *r, const decNumber *x);
+extern decNumber *native_QF_F(decNumber *r, const decNumber *x);
+extern decNumber *native_CDF_BINOMIAL(decNumber *r, const decNumber *x);
+extern decNumber *native_CDFU_BINOMIAL(decNumber *r, const decNumber *x);
+extern decNumber *native_QF_BINOMIAL(decNumber *r, const decNumber *x);
+extern decNumber *native_CDF_POISSON(decNumber *r, const decNumber *x);
+extern decNumber *native_CDFU_POISSON(decNumber *r, const decNumber *x);
+extern decNumber *native_QF_POISSON(decNumber *r, const decNumber *x);
+extern decNumber *native_CDF_POIS2(decNumber *r, const decNumber *x);
+extern decNumber *native_CDFU_POIS2(decNumber *r, const decNumber *x);
+extern decNumber *native_QF_POIS2(decNumber *r, const decNumber *x);
+#endif
+
 #endif
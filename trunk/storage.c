@@ -43,6 +43,14 @@
 #include <stdlib.h>
 #include <unistd.h>
 #endif
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+#ifdef MULTI_INSTANCE
+#include <pthread.h>
+#endif
 
 #define PERSISTENT_RAM
 #define SLCDCMEM
@@ -64,37 +72,37 @@
 /*
  *  Setup the persistent RAM
  */
-PERSISTENT_RAM TPersistentRam PersistentRam;
+PERSISTENT_RAM INSTANCE TPersistentRam PersistentRam;
 
 /*
  *  Data that is saved in the SLCD controller during deep sleep
  */
-SLCDCMEM TStateWhileOn StateWhileOn;
+SLCDCMEM INSTANCE TStateWhileOn StateWhileOn;
 
 /*
  *  A private register area for XROM code in volatile RAM
  *  It replaces the local registers and flags if active.
  */
-TXromParams XromParams;
-VOLATILE_RAM TXromLocal XromLocal;
+INSTANCE TXromParams XromParams;
+VOLATILE_RAM INSTANCE TXromLocal XromLocal;
 
 /* Private space for four registers temporarily
  */
-VOLATILE_RAM REGISTER XromA2D[4];
+VOLATILE_RAM INSTANCE REGISTER XromA2D[4];
 
 /*
  *  The backup flash area:
  *  2 KB for storage of programs and registers
  *  Same data as in persistent RAM but in flash memory
  */
-BACKUP_FLASH TPersistentRam BackupFlash;
+BACKUP_FLASH INSTANCE TPersistentRam BackupFlash;
 
 #ifndef REALBUILD
 /*
  *  We need to define the Library space here.
  *  On the device the linker takes care of this.
  */
-FLASH_REGION UserFlash;
+INSTANCE FLASH_REGION UserFlash;
 #endif
 
 /*
@@ -182,6 +190,7 @@ static void stoend( void )
 {
 	ProgSize = 1;
 	Prog[ 0 ] = ( OP_NIL | OP_END );
+	invalidate_label_index( REGION_RAM );
 }
 
 
@@ -227,6 +236,7 @@ void clrprog( void )
 			return;
 		}
 		clrretstk();
+		invalidate_label_index( REGION_RAM );
 		xcopy( Prog_1 + ProgBegin, Prog + ProgEnd, ( ProgSize - ProgEnd ) << 1 );
 		ProgSize -= ( ProgEnd + 1 - ProgBegin );
 		if ( ProgSize == 0 ) {
@@ -294,6 +304,7 @@ void stoprog( opcode c ) {
 	if ( ProgFree < off ) {
 		return;
 	}
+	invalidate_label_index( REGION_RAM );
 	ProgSize += off;
 	ProgEnd += off;
 	pc = do_inc( pc, 0 );	// Don't wrap on END
@@ -322,6 +333,7 @@ void delprog( void )
 		return;
 
 	clrretstk(); // ND change
+	invalidate_label_index( REGION_RAM );
 
 	off = isDBL( Prog_1[ pc ]) ? 2 : 1;
 	ProgSize -= off;
@@ -378,6 +390,7 @@ int append_program( const s_opcode *source, int length )
 	/*
 	 *  Append data
 	 */
+	invalidate_label_index( REGION_RAM );
 	pc = ProgSize + 1;
 	ProgSize += length;
 	xcopy( Prog_1 + pc, source, length << 1 );
@@ -442,6 +455,11 @@ static int program_flash( void *destination, void *source, int count )
 	return Error != 0;
 }
 
+/*
+ *  Flash is written directly, nothing to commit
+ */
+#define commit_flash( region ) 0
+
 
 /*
  *  Set the boot bit to ROM and turn off the device.
@@ -476,48 +494,272 @@ static char* get_region_path(int region)
 
 static int program_flash( void *destination, void *source, int count )
 {
-	char *name;
 	char *dest = (char *) destination;
-	FILE *f = NULL;
-	int offset;
+
+	if ( ! ( dest >= (char *) &BackupFlash && dest < (char *) &BackupFlash + sizeof( BackupFlash ) )
+	  && ! ( dest >= (char *) &UserFlash && dest < (char *) &UserFlash + sizeof( UserFlash ) ) ) {
+		// Bad address
+		report_err( ERR_ILLEGAL );
+		return 1;
+	}
 
 	/*
-	 *  Copy the source to the destination memory
+	 *  Copy the source to the destination memory.
+	 *  The file is updated by commit_flash() when the operation is complete.
 	 */
 	memcpy( dest, source, count * PAGE_SIZE );
+	return 0;
+}
 
-	/*
-	 *  Update the correct region file
-	 */
-	if ( dest >= (char *) &BackupFlash && dest < (char *) &BackupFlash + sizeof( BackupFlash ) ) {
-		name = get_region_path( REGION_BACKUP );
-		offset = dest - (char *) &BackupFlash;
-	}
-	else if ( dest >= (char *) &UserFlash && dest < (char *) &UserFlash + sizeof( UserFlash ) ) {
-		name = get_region_path( REGION_LIBRARY );
-		offset = dest - (char *) &UserFlash;
-	}
-	else {
-		// Bad address
-		report_err( ERR_ILLEGAL );
-		return 1;
+
+/*
+ *  What each region file is known to hold, the name is empty if unknown.
+ *  Only the pages that differ from this image are written to the file.
+ *  The cache is shared by all calculator instances, so with MULTI_INSTANCE
+ *  only one of them may commit at a time.
+ */
+#ifdef MULTI_INSTANCE
+static pthread_mutex_t flash_mutex = PTHREAD_MUTEX_INITIALIZER;
+#define flash_lock()	pthread_mutex_lock( &flash_mutex )
+#define flash_unlock()	pthread_mutex_unlock( &flash_mutex )
+#else
+#define flash_lock()
+#define flash_unlock()
+#endif
+
+static struct _region_file {
+	char name[ FILENAME_MAX + 1 ];
+	union {
+		TPersistentRam backup;
+		FLASH_REGION library;
+	} image;
+} RegionFile[ 2 ];
+
+#define JOURNAL_SUFFIX ".jnl"
+#define JOURNAL_END 0xffff
+
+static struct _region_file *region_file( int region, char **data, int *size )
+{
+	if ( region == REGION_BACKUP ) {
+		*data = (char *) &BackupFlash;
+		*size = sizeof( BackupFlash );
+		return RegionFile;
 	}
+	*data = (char *) &UserFlash;
+	*size = sizeof( UserFlash );
+	return RegionFile + 1;
+}
+
+static int page_length( int page, int size )
+{
+	const int length = size - page * PAGE_SIZE;
+	return length > PAGE_SIZE ? PAGE_SIZE : length;
+}
+
+/*
+ *  Make sure the data has reached the disk
+ */
+static int sync_file( FILE *f )
+{
+#ifdef _WIN32
+	return fflush( f ) || _commit( _fileno( f ) );
+#else
+	return fflush( f ) || fsync( fileno( f ) );
+#endif
+}
+
+static char *journal_name( char *buffer, const char *name )
+{
+	strncpy( buffer, name, FILENAME_MAX - sizeof( JOURNAL_SUFFIX ) );
+	buffer[ FILENAME_MAX - sizeof( JOURNAL_SUFFIX ) ] = '\0';
+	return strcat( buffer, JOURNAL_SUFFIX );
+}
+
+/*
+ *  Write the pages of a region that have changed since the last commit.
+ *  The pages go to a journal first which is synced before the region
+ *  file is touched, so an interrupted update can be completed on the
+ *  next start by recover_flash().
+ *  Journal records are the page number, the CRC and the page data,
+ *  terminated by JOURNAL_END.
+ */
+static int write_region( int region )
+{
+	char *data, *name = get_region_path( region );
+	int size;
+	struct _region_file *rf = region_file( region, &data, &size );
+	char *image = (char *) &rf->image;
+	const int pages = ( size + PAGE_SIZE - 1 ) / PAGE_SIZE;
+	int known = strcmp( rf->name, name ) == 0;
+	char changed[ ( sizeof( FLASH_REGION ) + PAGE_SIZE - 1 ) / PAGE_SIZE ];
+	char journal[ FILENAME_MAX + 1 ];
+	unsigned short record[ 2 ];
+	int page, offset, length, count = 0;
+	FILE *f, *j;
+
 	f = fopen( name, "rb+" );
 	if ( f == NULL ) {
 		f = fopen( name, "wb+" );
 	}
 	if ( f == NULL ) {
-		report_err( ERR_IO );
-		return 1;
+		goto failed;
 	}
-	fseek( f, offset, SEEK_SET );
-	if ( count != fwrite( dest, PAGE_SIZE, count, f ) ) {
+
+	/*
+	 *  If nothing is known about the file or it has been truncated
+	 *  behind our back, write it completely
+	 */
+	if ( fseek( f, 0, SEEK_END ) || ftell( f ) < size ) {
+		known = 0;
+	}
+	for ( page = 0; page < pages; ++page ) {
+		offset = page * PAGE_SIZE;
+		changed[ page ] = ! known || memcmp( data + offset, image + offset, page_length( page, size ) ) != 0;
+		count += changed[ page ];
+	}
+	if ( count == 0 ) {
 		fclose( f );
-		report_err( ERR_IO );
-		return 1;
+		return 0;
+	}
+	*rf->name = '\0';
+
+	/*
+	 *  Journal the changed pages
+	 */
+	j = fopen( journal_name( journal, name ), "wb" );
+	if ( j == NULL ) {
+		goto close;
+	}
+	for ( page = 0; page < pages; ++page ) {
+		if ( changed[ page ] ) {
+			offset = page * PAGE_SIZE;
+			length = page_length( page, size );
+			record[ 0 ] = page;
+			record[ 1 ] = crc16( data + offset, length );
+			if ( 1 != fwrite( record, sizeof( record ), 1, j ) 
+			  || 1 != fwrite( data + offset, length, 1, j ) ) {
+				fclose( j );
+				goto close;
+			}
+		}
+	}
+	record[ 0 ] = JOURNAL_END;
+	if ( 1 != fwrite( record, sizeof( record[ 0 ] ), 1, j ) || sync_file( j ) ) {
+		fclose( j );
+		goto close;
+	}
+	fclose( j );
+
+	/*
+	 *  Now update the region file in place
+	 */
+	for ( page = 0; page < pages; ++page ) {
+		if ( changed[ page ] ) {
+			offset = page * PAGE_SIZE;
+			length = page_length( page, size );
+			if ( fseek( f, offset, SEEK_SET ) || 1 != fwrite( data + offset, length, 1, f ) ) {
+				goto close;
+			}
+			xcopy( image + offset, data + offset, length );
+		}
+	}
+	if ( sync_file( f ) ) {
+		goto close;
 	}
 	fclose( f );
+	remove( journal );
+	strcpy( rf->name, name );
 	return 0;
+
+close:
+	fclose( f );
+failed:
+	report_err( ERR_IO );
+	return 1;
+}
+
+static int commit_flash( int region )
+{
+	int ret;
+
+	flash_lock();
+	ret = write_region( region );
+	flash_unlock();
+	return ret;
+}
+
+
+/*
+ *  Complete an update of a region file that was interrupted and
+ *  remember what the file holds.  Called before the region is loaded.
+ *  A journal that isn't complete is discarded, the file wasn't touched.
+ */
+void recover_flash( int region )
+{
+	char *data, *name = get_region_path( region );
+	int size;
+	struct _region_file *rf = region_file( region, &data, &size );
+	char *image = (char *) &rf->image;
+	const int pages = ( size + PAGE_SIZE - 1 ) / PAGE_SIZE;
+	char journal[ FILENAME_MAX + 1 ];
+	char buffer[ PAGE_SIZE ];
+	unsigned short record[ 2 ];
+	int length;
+	long end;
+	FILE *f, *j;
+
+	*rf->name = '\0';
+	j = fopen( journal_name( journal, name ), "rb" );
+	if ( j != NULL ) {
+		/*
+		 *  Check the journal
+		 */
+		while ( 1 == fread( record, sizeof( record[ 0 ] ), 1, j ) && record[ 0 ] < pages ) {
+			length = page_length( record[ 0 ], size );
+			if ( 1 != fread( record + 1, sizeof( record[ 1 ] ), 1, j ) 
+			  || 1 != fread( buffer, length, 1, j ) 
+			  || record[ 1 ] != crc16( buffer, length ) ) {
+				break;
+			}
+		}
+		if ( ! feof( j ) && ! ferror( j ) && record[ 0 ] == JOURNAL_END ) {
+			/*
+			 *  Replay it
+			 */
+			f = fopen( name, "rb+" );
+			if ( f == NULL ) {
+				f = fopen( name, "wb+" );
+			}
+			if ( f != NULL ) {
+				rewind( j );
+				while ( 1 == fread( record, sizeof( record[ 0 ] ), 1, j ) && record[ 0 ] != JOURNAL_END ) {
+					length = page_length( record[ 0 ], size );
+					fread( record + 1, sizeof( record[ 1 ] ), 1, j );
+					fread( buffer, length, 1, j );
+					fseek( f, record[ 0 ] * PAGE_SIZE, SEEK_SET );
+					fwrite( buffer, length, 1, f );
+				}
+				sync_file( f );
+				fclose( f );
+			}
+		}
+		fclose( j );
+		remove( journal );
+	}
+
+	/*
+	 *  Remember the file contents if the file is complete
+	 */
+	f = fopen( name, "rb" );
+	if ( f != NULL ) {
+		fseek( f, 0, SEEK_END );
+		end = ftell( f );
+		rewind( f );
+		if ( end >= size && 1 == fread( image, size, 1, f ) ) {
+			strcpy( rf->name, name );
+		}
+		fclose( f );
+	}
 }
 #endif
 
@@ -536,7 +778,10 @@ void init_library( void )
 		lib.size = 0;
 		lib.crc = MAGIC_MARKER;
 		xset( lib.prog, 0xff, sizeof( lib.prog ) );
-		program_flash( &UserFlash, &lib, 1 );
+		invalidate_label_index( REGION_LIBRARY );
+		if ( program_flash( &UserFlash, &lib, 1 ) == 0 ) {
+			commit_flash( REGION_LIBRARY );
+		}
 	}
 }
 
@@ -559,6 +804,8 @@ static int flash_append( int destination_step, const s_opcode *source, int count
 	FLASH_REGION *fr = (FLASH_REGION *) buffer;
 	count <<= 1;
 
+	invalidate_label_index( REGION_LIBRARY );
+
 	if ( offset_in_page != 0 ) {
 		/*
 		 *  We are not on a page boundary
@@ -591,7 +838,10 @@ static int flash_append( int destination_step, const s_opcode *source, int count
 	xcopy( fr, &UserFlash, PAGE_SIZE );
 	fr->size = size;
 	checksum_region( &UserFlash, fr );
-	return program_flash( &UserFlash, fr, 1 );
+	if ( program_flash( &UserFlash, fr, 1 ) ) {
+		return 1;
+	}
+	return commit_flash( REGION_LIBRARY );
 }
 
 
@@ -619,7 +869,9 @@ void flash_backup( enum nilop op )
 		init_state();
 		checksum_all();
 
-		if ( program_flash( &BackupFlash, &PersistentRam, sizeof( BackupFlash ) / PAGE_SIZE ) ) {
+		invalidate_label_index( REGION_BACKUP );
+		if ( program_flash( &BackupFlash, &PersistentRam, sizeof( BackupFlash ) / PAGE_SIZE )
+		  || commit_flash( REGION_BACKUP ) ) {
 			report_err( ERR_IO );
 			DispMsg = "Error";
 		}
@@ -638,6 +890,7 @@ void flash_restore( enum nilop op )
 		}
 		else {
 			xcopy( &PersistentRam, &BackupFlash, sizeof( PersistentRam ) );
+			invalidate_label_index( REGION_RAM );
 			init_state();
 			DispMsg = "Restored";
 		}
@@ -941,6 +1194,8 @@ void load_statefile(const char *filename )
 		fread( &PersistentRam, sizeof( PersistentRam ), 1, f );
 		fclose( f );
 	}
+	recover_flash( REGION_BACKUP );
+	recover_flash( REGION_LIBRARY );
 	f = fopen( expand_filename( buffer, BACKUP_FILE ), "rb" );
 	if ( f != NULL ) {
 		fread( &BackupFlash, sizeof( BackupFlash ), 1, f );
@@ -955,6 +1210,7 @@ void load_statefile(const char *filename )
 		fread( &UserFlash, sizeof( UserFlash ), 1, f );
 		fclose( f );
 	}
+	invalidate_label_index( -1 );
 	init_library();
 
 #if !defined(QTGUI) && !defined(IOS)
@@ -992,8 +1248,9 @@ void load_statefile(const char *filename )
 
 /*
  *  Import text file
+ *  Show the assembler log, returns the assembler status
  */
-static void show_log( char *logname, int rc )
+static int show_log( char *logname, int rc )
 {
 	char msg[ 10000 ] = "";
 	FILE *f = fopen( logname, "rt" );
@@ -1009,6 +1266,7 @@ static void show_log( char *logname, int rc )
 		sprintf( msg, "Cannot execute assembler %s, RC=%d", Assembler, rc );
 	}
 	ShowMessage( rc == 0 ? "Import Result" : "Import Failed", msg );
+	return rc;
 }
 
 static char* mktmpname(char* name, const char* prefix)
@@ -1049,7 +1307,12 @@ static char* getTmpDir()
 #endif
 
 #define IMPORT_BUFFER_SIZE 10000
-void import_textfile( const char *filename )
+
+/*
+ *  Run the external assembler, it knows about the preprocessor syntax
+ *  Returns non zero in case of failure.
+ */
+static int import_external( const char *filename )
 {
 #ifdef QTGUI
 	char previousDir[ IMPORT_BUFFER_SIZE ];
@@ -1075,8 +1338,7 @@ void import_textfile( const char *filename )
 	getcwd(previousDir, IMPORT_BUFFER_SIZE);
 	chdir(getTmpDir());
 #endif
-	rc = system( buffer );
-	show_log( logname, rc );
+	rc = show_log( logname, system( buffer ) );
 	if ( rc == 0 ) {
 		// Assembly successful
 		int size, words = 0;
@@ -1084,6 +1346,7 @@ void import_textfile( const char *filename )
 
 		if ( f == NULL ) {
 			ShowMessage( "Import Failed", "Assembler output file error: %s", strerror( errno ) );
+			rc = 1;
 		}
 		else {
 			size = (int) fread( buffer, 2, sizeof( buffer ) / 2, f );
@@ -1094,9 +1357,10 @@ void import_textfile( const char *filename )
 			if ( words != size - 3 ) {
 				// Bad file size
 				ShowMessage( "Import Failed", "Bad assembler output file size %d", size );
+				rc = 1;
 			}
 			else {
-				append_program( (s_opcode *) ( buffer + 4 ), words );
+				rc = append_program( (s_opcode *) ( buffer + 4 ), words );
 				update_program_bounds( 1 );
 			}
 		}
@@ -1106,8 +1370,67 @@ void import_textfile( const char *filename )
 #ifdef QTGUI
 	chdir(previousDir);
 #endif
+	return rc;
 }
 
+/*
+ *  Import: Assemble a text file in process, files using the preprocessor
+ *  syntax are handed to the external assembler if there is one.
+ *  Any other error is shown with the line it was found on.
+ *  Returns non zero if the file couldn't be assembled and loaded.
+ */
+int import_textfile( const char *filename )
+{
+	static INSTANCE s_opcode prog[ NUMPROG_LIMIT ];
+	char msg[ 1000 ];
+	FILE *f;
+	int words;
+
+	words = assemble_file( filename, prog, NUMPROG_LIMIT, msg, sizeof( msg ) );
+	if ( words > 0 ) {
+		if ( append_program( prog, words ) ) {
+			ShowMessage( "Import Failed", "Program doesn't fit" );
+			return 1;
+		}
+		update_program_bounds( 1 );
+		ShowMessage( "Import Result", msg );
+		return 0;
+	}
+	f = words == ASM_PREPROCESSOR && *Assembler != '\0' ? fopen( Assembler, "r" ) : NULL;
+	if ( f != NULL ) {
+		fclose( f );
+		return import_external( filename );
+	}
+	ShowMessage( "Import Failed", msg );
+	return 1;
+}
+
+#ifdef MULTI_INSTANCE
+/*
+ *  Save the calculator of the calling thread to an instance or make an
+ *  instance the calculator of the calling thread.  Don't switch while a
+ *  program is running.
+ */
+void instance_save( CALC_INSTANCE *c )
+{
+	c->ram = PersistentRam;
+	c->state = StateWhileOn;
+	c->backup = BackupFlash;
+	c->library = UserFlash;
+}
+
+void instance_load( const CALC_INSTANCE *c )
+{
+	PersistentRam = c->ram;
+	StateWhileOn = c->state;
+	BackupFlash = c->backup;
+	UserFlash = c->library;
+	invalidate_label_index( -1 );
+	xeq_init_contexts();
+	ShowRPN = 1;
+}
+#endif
+
 /*
  *  Export: Print current program to text file
  */
@@ -35,8 +35,8 @@ typedef struct _flash_region {
         s_opcode prog[ NUMPROG_FLASH ];
 } FLASH_REGION;
 
-extern FLASH_REGION UserFlash;
-extern TPersistentRam BackupFlash;
+extern INSTANCE FLASH_REGION UserFlash;
+extern INSTANCE TPersistentRam BackupFlash;
 
 #ifndef REALBUILD
 // Flag for "Export Program..."
@@ -62,6 +62,9 @@ extern void reset(void);
 extern void flash_backup(enum nilop op);
 extern void flash_restore(enum nilop op);
 extern int flash_remove( int step_no, int count );
+#ifndef REALBUILD
+extern void recover_flash( int region );
+#endif
 extern void sam_ba_boot(void);
 extern void save_program(enum nilop op);
 extern void load_program(enum nilop op);
@@ -77,9 +80,27 @@ extern char ComPort[];
 extern char Assembler[];
 extern void save_statefile( const char *filename );
 extern void load_statefile( const char *filename );
-extern void import_textfile( const char *filename );
+extern int import_textfile( const char *filename );
 extern void export_textfile( const char *filename );
 extern void set_assembler(const char* assembler);
+extern int assemble_step( const char *line, s_opcode *words, char *message );
+extern int assemble_file( const char *filename, s_opcode *prog, int max, char *message, int length );
+#define ASM_PREPROCESSOR (-2)	// assemble_file(): the file needs the external assembler
 #endif
 
+#ifdef MULTI_INSTANCE
+/*
+ *  A calculator that isn't the current one of any thread
+ */
+typedef struct _calc_instance {
+	TPersistentRam ram;
+	TStateWhileOn state;
+	TPersistentRam backup;
+	FLASH_REGION library;
+} CALC_INSTANCE;
+
+extern void instance_save( CALC_INSTANCE *c );
+extern void instance_load( const CALC_INSTANCE *c );
 #endif
+
+#endif
@@ -0,0 +1,118 @@
+#!/usr/bin/perl -w
+#-----------------------------------------------------------------------
+#
+#  This file is part of 34S.
+#
+#  34S is free software: you can redistribute it and/or modify
+#  it under the terms of the GNU General Public License as published by
+#  the Free Software Foundation, either version 3 of the License, or
+#  (at your option) any later version.
+#
+#  34S is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#  GNU General Public License for more details.
+#
+#  You should have received a copy of the GNU General Public License
+#  along with 34S.  If not, see <http://www.gnu.org/licenses/>.
+#
+#-----------------------------------------------------------------------
+#
+my $Description = "Compare the native distributions with the XROM ones.";
+#
+#-----------------------------------------------------------------------
+#
+# Language:         Perl script
+#
+# Usage:            distcheck.pl jobs xrom.out native.out
+#
+# Both outputs come from "calc batch" running the jobs file.  A job must
+# give the same status and error either way.  Single precision results
+# must be equal, double precision ones may differ by 1e-31 relative.
+# A job preceded by a "# xrom" comment line is one where XROM is known
+# to get it wrong: it is counted but not compared.
+#
+#-----------------------------------------------------------------------
+
+use strict;
+use JSON::PP;
+use Math::BigFloat;
+
+my $DP_Tolerance = Math::BigFloat->new("1e-31");
+
+die "Usage: $0 jobs xrom.out native.out\n" unless @ARGV == 3;
+my ($jobfile, $xromfile, $nativefile) = @ARGV;
+
+# Job numbers count the lines of the jobs file, comments included.
+my (@jobs, %known);
+open JOBS, "<", $jobfile or die "$jobfile: $!\n";
+while (<JOBS>) {
+  chomp;
+  push @jobs, $_;
+  $known{scalar(@jobs) + 1} = 1 if /^#\s*xrom/;
+}
+close JOBS;
+
+sub load {
+  my $file = shift;
+  my %res;
+
+  open OUT, "<", $file or die "$file: $!\n";
+  while (<OUT>) {
+    my $j = decode_json($_);
+    $res{$j->{job}} = $j;
+  }
+  close OUT;
+  return \%res;
+}
+
+my $xrom = load($xromfile);
+my $native = load($nativefile);
+
+my ($jobs, $failed, $skipped, $xrom_usec, $native_usec) = (0, 0, 0, 0, 0);
+foreach my $n (sort { $a <=> $b } keys %$xrom) {
+  my ($x, $y) = ($xrom->{$n}, $native->{$n});
+  my $job = $jobs[$n - 1];
+  my $why;
+
+  $jobs++;
+  $xrom_usec += $x->{usec};
+  unless (defined $y) {
+    print "$job: no native result\n";
+    $failed++;
+    next;
+  }
+  $native_usec += $y->{usec};
+  if ($known{$n}) {
+    $skipped++;
+    next;
+  }
+  if ($x->{status} ne $y->{status} or $x->{error} != $y->{error}) {
+    $why = "status";
+  } elsif ($x->{status} eq "ok") {
+    my $u = Math::BigFloat->new($x->{stack}[0]);
+    my $v = Math::BigFloat->new($y->{stack}[0]);
+
+    if ($u->is_nan() or $v->is_nan()) {
+      $why = "value" unless $u->is_nan() and $v->is_nan();
+    } elsif ($job =~ /\bR00=1\b/) {
+      my $d = $u->copy()->bsub($v)->babs();
+      my $m = $u->copy()->babs();
+
+      $m = $v->copy()->babs() if $v->copy()->babs() > $m;
+      $why = "value" if $d > $m->bmul($DP_Tolerance);
+    } elsif ($u != $v) {
+      $why = "value";
+    }
+  }
+  if (defined $why) {
+    printf "%s: %s differs, XROM %s %s, native %s %s\n", $job, $why,
+      $x->{status}, $x->{stack}[0], $y->{status}, $y->{stack}[0];
+    $failed++;
+  }
+}
+
+printf "%d jobs, %d known XROM failures, %d differ\n", $jobs, $skipped, $failed;
+printf "XROM %d usec, native %d usec, %.2f times faster\n",
+  $xrom_usec, $native_usec, $native_usec ? $xrom_usec / $native_usec : 0;
+exit($failed != 0);
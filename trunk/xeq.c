@@ -55,6 +55,7 @@ extern unsigned long long strtoull(const char *, char **, int);
 #include "alpha.h"
 #include "stopwatch.h"
 #include "printer.h"
+#include "profile.h"
 
 #include "xrom_targets.c"	// Generated by PP
 
@@ -66,8 +67,8 @@ extern unsigned long long strtoull(const char *, char **, int);
 /*
  *  A program is running
  */
-FLAG Running;
-FLAG XromRunning;
+INSTANCE FLAG Running;
+INSTANCE FLAG XromRunning;
 
 #ifndef CONSOLE
 /*
@@ -79,68 +80,68 @@ FLAG JustStopped;
 /*
  *  Count down counter for a programmed pause
  */
-volatile unsigned char Pause;
+INSTANCE volatile unsigned char Pause;
 
 /*
  *  Some long running function has called busy();
  */
-FLAG Busy;
+INSTANCE FLAG Busy;
 
 /*
  *  Error code
  */
-SMALL_INT Error;
+INSTANCE SMALL_INT Error;
 
 /*
  *  Indication of PC wrap around
  */
-FLAG PcWrapped;
+INSTANCE FLAG PcWrapped;
 
 /*
  *  Currently executed function
  */
-s_opcode XeqOpCode;
+INSTANCE s_opcode XeqOpCode;
 
 /*
  *  Temporary display (not X)
  */
-SMALL_INT ShowRegister;
+INSTANCE SMALL_INT ShowRegister;
 
 /*
  *  User code being called from XROM
  */
-SMALL_INT XromUserPc;
-SMALL_INT UserLocalRegs;
+INSTANCE SMALL_INT XromUserPc;
+INSTANCE SMALL_INT UserLocalRegs;
 
 /* We need various different math contexts.
  * More efficient to define these globally and reuse them as needed.
  */
-decContext Ctx;
+INSTANCE decContext Ctx;
 
 /*
  * A buffer for instruction display
  */
-char TraceBuffer[25];
+INSTANCE char TraceBuffer[25];
 
 /*
  *  Total Size of the return stack
  */
-SMALL_INT RetStkSize;
+INSTANCE SMALL_INT RetStkSize;
 
 /*
  *  Number of remaining program steps
  */
-SMALL_INT ProgFree;
+INSTANCE SMALL_INT ProgFree;
 
 /*
  * The actual top of the return stack
  */
-unsigned short *RetStk;
+INSTANCE unsigned short *RetStk;
 
 /*
  *  The location of the RPN stack
  */
-REGISTER *StackBase;
+INSTANCE REGISTER *StackBase;
 
 #ifdef INFRARED
 /*
@@ -153,7 +154,7 @@ FLAG Tracing;
 *	Indicates that a coordinate converstion has just happened
 */
 #ifdef RP_PREFIX
-SMALL_INT RectPolConv; // 1 - R->P just done; 2 - P->R just done
+INSTANCE SMALL_INT RectPolConv; // 1 - R->P just done; 2 - P->R just done
 #endif
 
 /*
@@ -265,12 +266,19 @@ static void raw_set_pc(unsigned int pc) {
 /*
  *  Where do the program regions start?
  */
+#ifndef MULTI_INSTANCE
 static const s_opcode *const RegionTab[] = {
 	Prog,
 	UserFlash.prog,
 	BackupFlash._prog,
 	xrom
 };
+#define REGION_START(r)	(RegionTab[r])
+#else
+// Thread local addresses aren't constant
+#define REGION_START(r)	((r) == REGION_RAM ? Prog : (r) == REGION_LIBRARY ? UserFlash.prog \
+			 : (r) == REGION_BACKUP ? BackupFlash._prog : xrom)
+#endif
 
 /*
  *  Size of a program segment
@@ -279,7 +287,7 @@ int sizeLIB(int region) {
 	if (region == REGION_XROM)
 		return xrom_size;
 	else
-		return (int)RegionTab[region][-1];
+		return (int)REGION_START(region)[-1];
 }
 
 
@@ -306,7 +314,7 @@ opcode getprog(unsigned int pc) {
 
 	if (offset < 0 || offset >= sizeLIB(region))
 		return OP_NIL | OP_END;
-	return get_opcode(RegionTab[region] + offset);
+	return get_opcode(REGION_START(region) + offset);
 }
 
 
@@ -316,7 +324,7 @@ opcode getprog(unsigned int pc) {
 const s_opcode *get_current_prog(void) {
 
 	const int region = nLIB(ProgBegin);
-	return RegionTab[region] + offsetLIB(ProgBegin);
+	return REGION_START(region) + offsetLIB(ProgBegin);
 }
 
 
@@ -682,8 +690,144 @@ static REGISTER *get_stack_top(void) {
 	return get_stack(stack_size()-1);
 }
 
+#ifdef UNDO_JOURNAL
+/*
+ *  Undo journal for xeq().  Each active call of xeq() has a frame which
+ *  covers the same STACK_SIZE+2 register slots the old snapshot did.
+ *  A slot is copied into the frame the first time it is written, so
+ *  an error only needs to put back what has actually changed.
+ *  Frames nest because XROM code runs inside the calling xeq().
+ */
+#define JOURNAL_SLOTS	(STACK_SIZE+2)
+#define JOURNAL_ALL	((1 << JOURNAL_SLOTS) - 1)
+
+struct _journal {
+	struct _journal *prev;
+	REGISTER *save;
+	char *base;
+	unsigned short saved;
+};
+static INSTANCE struct _journal *Journal;
+
+/*
+ *  Save the slots in mask that haven't been saved yet, each run of
+ *  adjacent slots in one go.  The frame never overlaps the stack.
+ */
+static void journal_slots(struct _journal *j, unsigned int mask) {
+	int i, n;
+
+	mask &= JOURNAL_ALL & ~j->saved;
+	j->saved |= mask;
+	for (i = 0; i < JOURNAL_SLOTS; i = n) {
+		while (i < JOURNAL_SLOTS && ! (mask & (1 << i)))
+			++i;
+		for (n = i; n < JOURNAL_SLOTS && (mask & (1 << n)); ++n)
+			;
+		if (n > i)
+			memcpy(j->save + i, j->base + i * sizeof(REGISTER), (n - i) * sizeof(REGISTER));
+	}
+}
+
+/*
+ *  Called by the register write primitives before they modify memory.
+ */
+static void journal_write(const void *p, int n) {
+	struct _journal *j;
+
+	for (j = Journal; j != NULL; j = j->prev) {
+		const char *const d = (const char *) p;
+		int first, last;
+
+		if (j->saved == JOURNAL_ALL
+				|| d + n <= j->base
+				|| d >= j->base + JOURNAL_SLOTS * sizeof(REGISTER))
+			continue;
+		first = d <= j->base ? 0 : (d - j->base) / sizeof(REGISTER);
+		last = (d + n - 1 - j->base) / sizeof(REGISTER);
+		if (last >= JOURNAL_SLOTS)
+			last = JOURNAL_SLOTS - 1;
+		journal_slots(j, ((2 << last) - 1) & ~((1 << first) - 1));
+	}
+}
+
+/*
+ *  Commands known to modify the stack only through the primitives below.
+ */
+static int journal_lazy(opcode op) {
+	if (isDBL(op))
+		return opDBL(op) <= DBL_GTO;
+	if (isRARG(op)) {
+		const unsigned int cmd = RARG_CMD(op);
+
+		return (cmd >= RARG_STO && cmd <= RARG_CSWAPZ)
+			|| cmd == RARG_STOSTK || cmd == RARG_RCLSTK
+			|| (cmd >= RARG_SKIP && cmd <= RARG_BSB)
+			|| (cmd >= RARG_LBL && cmd <= RARG_GTO);
+	}
+	switch (opKIND(op)) {
+	case KIND_MON:
+	case KIND_DYA:
+	case KIND_TRI:
+	case KIND_CMON:
+	case KIND_CDYA:
+		return 1;
+	default:
+		return 0;
+	}
+}
+
+/*
+ *  Open a frame for xeq().  Slots past the real stack registers hold
+ *  other state in single precision and are always saved up front.
+ *  Any other command takes the full snapshot, and so must all enclosing
+ *  frames because such commands may write the stack directly.
+ */
+static void journal_begin(struct _journal *j, REGISTER *save, opcode op) {
+	j->prev = Journal;
+	j->save = save;
+	j->base = (char *) StackBase;
+	j->saved = 0;
+
+	if (journal_lazy(op)) {
+		const int top = ((char *) get_reg_n(regK_idx) - j->base)
+			+ (is_dblmode() ? sizeof(decimal128) : sizeof(decimal64));
+
+		if (top < JOURNAL_SLOTS * (int) sizeof(REGISTER))
+			journal_slots(j, JOURNAL_ALL & ~((1 << (top / sizeof(REGISTER))) - 1));
+	} else {
+		struct _journal *p;
+
+		for (p = j; p != NULL; p = p->prev)
+			journal_slots(p, JOURNAL_ALL);
+	}
+	Journal = j;
+}
+
+/*
+ *  Repair the stack after an error, StackBase may have moved since.
+ */
+static void journal_restore(const struct _journal *j) {
+	char *const d = (char *) StackBase;
+	int i;
+
+	for (i = 0; i < JOURNAL_SLOTS; ++i) {
+		const int offset = i * sizeof(REGISTER);
+
+		if (j->saved & (1 << i))
+			xcopy(d + offset, j->save + i, sizeof(REGISTER));
+		else if (d != j->base)
+			xcopy(d + offset, j->base + offset, sizeof(REGISTER));
+	}
+}
+#else
+#define journal_write(p, n)
+#endif
+
 void copyreg(REGISTER *d, const REGISTER *s) {
-	xcopy(d, s, is_dblmode() ? sizeof(decimal128) : sizeof(decimal64));
+	const int n = is_dblmode() ? sizeof(decimal128) : sizeof(decimal64);
+
+	journal_write(d, n);
+	xcopy(d, s, n);
 }
 
 void copyreg_n(int d, int s) {
@@ -748,13 +892,55 @@ static void setlastXY(void) {
 }
 
 
+#ifdef REGISTER_CACHE
+#include <stdint.h>
+
+/*
+ *  Unpacked copies of recently read registers, one slot per register address.
+ *  A slot is only used while memory still holds the packed value it was made
+ *  from, so stores, undo, flash loads and mode switches never have to touch it
+ *  and the packed register contents stay exactly what they were.
+ */
+#define REGISTER_CACHE_SIZE	32
+
+static INSTANCE struct _register_cache {
+	REGISTER packed;
+	unsigned char valid;
+	unsigned char dbl;
+	decNumber n;
+} RegisterCache[REGISTER_CACHE_SIZE];
+
+static decNumber *get_cached_register(decNumber *r, const REGISTER *reg) {
+	struct _register_cache *const c = RegisterCache
+		+ (((uintptr_t) reg / sizeof(decimal64)) & (REGISTER_CACHE_SIZE - 1));
+	const unsigned char dbl = is_dblmode();
+	const int n = dbl ? sizeof(decimal128) : sizeof(decimal64);
+
+	if (! c->valid || c->dbl != dbl || memcmp(&c->packed, reg, n) != 0) {
+		if (dbl)
+			decimal128ToNumber(&(reg->d), &c->n);
+		else
+			decimal64ToNumber(&(reg->s), &c->n);
+		xcopy(&c->packed, reg, n);
+		c->dbl = dbl;
+		c->valid = 1;
+	}
+	*r = c->n;
+	return r;
+}
+#endif
+
 decNumber *getRegister(decNumber *r, int index) {
 	const REGISTER *const reg = get_reg_n(index);
+#ifdef REGISTER_CACHE
+	return get_cached_register(r, reg);
+#else
 	if (is_dblmode())
 		decimal128ToNumber(&(reg->d), r);
 	else
 		decimal64ToNumber(&(reg->s), r);
 	return r;
+#endif
 }
 
 void setRegister(int index, const decNumber *x) {
@@ -763,6 +949,7 @@ void setRegister(int index, const decNumber *x) {
 
 	if (! check_special(x)) {	/* This correctly deals with infinities and NaN based on flag D */
 		decNumberNormalize(&dn, x, &Ctx);
+		journal_write(reg, is_dblmode() ? sizeof(decimal128) : sizeof(decimal64));
 		if (is_dblmode())
 			packed128_from_number(&(reg->d), &dn);
 		else
@@ -1201,25 +1388,81 @@ REGISTER *get_flash_reg_n(int n) {
 }
 
 
+#ifdef CONST_CACHE
+/*
+ *  Constants converted to the other precision and unpacked,
+ *  filled in on first use.  The tables never change, so neither do these.
+ */
+#define CONST_PACKED	1
+#define CONST_NUMBER	2
+
+static INSTANCE struct _const_cache {
+	REGISTER packed;
+	decNumber n;
+	unsigned char valid;
+} ConstCache[NUM_CONSTS][2];
+
+static INSTANCE struct _conv_cache {
+	decNumber n;
+	unsigned char valid;
+} ConvCache[NUM_CONSTS_CONV];
+#endif
+
 /*
  *  Get a constatnt by index and mode
  *  In case of a conversion, a private copy is returned
  */
 REGISTER *get_const(int index, int dbl)
 {
-	static REGISTER result;
+#ifdef CONST_CACHE
+	struct _const_cache *const c = &ConstCache[index][dbl != 0];
+	REGISTER *const result = &(c->packed);
+#else
+	static INSTANCE REGISTER copy;
+	REGISTER *const result = &copy;
+#endif
 	const int i = cnsts[index].index;
 	if (dbl) {
 		if (i <= 1 || i >= 128)
 			return (REGISTER *) (cnsts_d128 + (i & 0x7f));
-		packed128_from_packed(&(result.d), cnsts_d64 + i);
 	}
 	else {
 		if (i < 128)
 			return (REGISTER *) (cnsts_d64 + i);
-		packed_from_packed128(&(result.s), cnsts_d128 - 128 + i);
 	}
-	return &result;
+#ifdef CONST_CACHE
+	if (c->valid & CONST_PACKED)
+		return result;
+	c->valid |= CONST_PACKED;
+#endif
+	if (dbl)
+		packed128_from_packed(&(result->d), cnsts_d64 + i);
+	else
+		packed_from_packed128(&(result->s), cnsts_d128 - 128 + i);
+	return result;
+}
+
+/*
+ *  Get a constant by index and mode as a decNumber
+ */
+decNumber *get_const_number(decNumber *r, int index, int dbl)
+{
+#ifdef CONST_CACHE
+	struct _const_cache *const c = &ConstCache[index][dbl != 0];
+
+	if ((c->valid & CONST_NUMBER) == 0) {
+		if (dbl)
+			decimal128ToNumber(&(get_const(index, 1)->d), &(c->n));
+		else
+			decimal64ToNumber(&(get_const(index, 0)->s), &(c->n));
+		c->valid |= CONST_NUMBER;
+	}
+	return decNumberCopy(r, &(c->n));
+#else
+	if (dbl)
+		return decimal128ToNumber(&(get_const(index, 1)->d), r);
+	return decimal64ToNumber(&(get_const(index, 0)->s), r);
+#endif
 }
 
 
@@ -1233,7 +1476,10 @@ long long int get_reg_n_int(int index) {
 }
 
 void set_reg_n_int(int index, long long int ll) {
-	xcopy(get_reg_n(index), &ll, sizeof(ll));
+	REGISTER *const reg = get_reg_n(index);
+
+	journal_write(reg, sizeof(ll));
+	xcopy(reg, &ll, sizeof(ll));
 }
 
 /* Get an integer from a register
@@ -1343,6 +1589,7 @@ void zero_regs(REGISTER *dest, int n) {
 #else
 	// This works for all modes
 	// no it doesn't -- it leaves varying values of zero around
+	journal_write(dest, n << (3 + is_dblmode()));
 	xset(dest, 0, n << (3 + is_dblmode()));
 #endif
 }
@@ -1350,6 +1597,7 @@ void zero_regs(REGISTER *dest, int n) {
 void move_regs(REGISTER *dest, REGISTER *src, int n) {
 	if (is_dblmode())
 		n <<= 1;
+	journal_write(dest, n << 3);
 	xcopy(dest, src, n << 3);
 }
 
@@ -1974,16 +2222,153 @@ static void retstk_up(void)
 }
 
 
+#ifdef LABEL_INDEX
+/*
+ *  Index of all labels in a program region, sorted by opcode and address.
+ *  It is built on first use and thrown away whenever the region changes.
+ */
+struct _label_entry {
+	opcode op;
+	unsigned short int pc;
+};
+
+static INSTANCE struct _label_index {
+	int valid;
+	int size;			// Size of the region when the index was built
+	int count;
+	int max;
+	struct _label_entry *entries;
+} LabelIndex[REGION_XROM + 1];
+
+static int is_label(const opcode op) {
+	if (isDBL(op))
+		return opDBL(op) == DBL_LBL;
+	return isRARG(op) && RARG_CMD(op) == RARG_LBL;
+}
+
+static int label_entry_compare(const void *v1, const void *v2) {
+	const struct _label_entry *e1 = (const struct _label_entry *) v1;
+	const struct _label_entry *e2 = (const struct _label_entry *) v2;
+
+	if (e1->op != e2->op)
+		return e1->op < e2->op ? -1 : 1;
+	return (int) e1->pc - (int) e2->pc;
+}
+
+/*
+ *  Throw away the index of a region, a negative region clears them all.
+ */
+void invalidate_label_index(int region) {
+	int i;
+
+	for (i = 0; i <= REGION_XROM; ++i)
+		if (region < 0 || region == i)
+			LabelIndex[i].valid = 0;
+}
+
+static struct _label_index *build_label_index(int region) {
+	struct _label_index *const li = LabelIndex + region;
+	const s_opcode *const base = REGION_START(region);
+	const int size = sizeLIB(region);
+	int offset;
+
+	li->count = 0;
+	for (offset = 0; offset < size; offset += 1 + isDBL(base[offset])) {
+		const opcode op = get_opcode(base + offset);
+
+		if (! is_label(op))
+			continue;
+		if (li->count == li->max) {
+			struct _label_entry *p = (struct _label_entry *)
+				realloc(li->entries, (li->max + 64) * sizeof(struct _label_entry));
+			if (p == NULL)
+				return NULL;
+			li->entries = p;
+			li->max += 64;
+		}
+		li->entries[li->count].op = op;
+		li->entries[li->count].pc = addrLIB(offset + 1, region);
+		li->count++;
+	}
+	qsort(li->entries, li->count, sizeof(struct _label_entry), &label_entry_compare);
+	li->size = size;
+	li->valid = 1;
+	return li;
+}
+
+/*
+ *  Return the index of the first entry not less than (l, pc)
+ */
+static int label_lower_bound(const struct _label_index *li, const opcode l, unsigned int pc) {
+	int lo = 0, hi = li->count;
+
+	while (lo < hi) {
+		const int mid = (lo + hi) >> 1;
+		const struct _label_entry *e = li->entries + mid;
+
+		if (e->op < l || (e->op == l && e->pc < pc))
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+	return lo;
+}
+
+/*
+ *  Indexed equivalent of the linear search in find_opcode_from().
+ *  Looks from pc to bottom and then wraps around from top.
+ *  Returns 0 if the label isn't there, ~0 if the index is unusable.
+ */
+static unsigned int find_indexed_label(unsigned int pc, const opcode l,
+				       unsigned int top, unsigned int bottom) {
+	const int region = nLIB(top);
+	struct _label_index *li = LabelIndex + region;
+	int i;
+
+	if (! li->valid || li->size != sizeLIB(region)) {
+		li = build_label_index(region);
+		if (li == NULL)
+			return ~0u;
+	}
+	i = label_lower_bound(li, l, pc);
+	if (i == li->count || li->entries[i].op != l || li->entries[i].pc > bottom) {
+		// Nothing behind pc, wrap around
+		i = label_lower_bound(li, l, top);
+		if (i == li->count || li->entries[i].op != l || li->entries[i].pc >= pc)
+			return 0;
+	}
+	pc = li->entries[i].pc;
+	if (getprog(pc) != l) {
+		// Somebody has changed the program behind our back
+		li->valid = 0;
+		return ~0u;
+	}
+	return pc;
+}
+#endif
+
+
 /* Search from the given position for the specified numeric label.
  */
 unsigned int find_opcode_from(unsigned int pc, const opcode l, const int flags) {
 	unsigned short int top;
+	unsigned int bottom;
 	int count;
 	const int endp = flags & FIND_OP_ENDS;
 	const int errp = flags & FIND_OP_ERROR;
 
-	count = 1 + find_section_bounds(pc, endp, &top);
-	count -= top;
+	bottom = find_section_bounds(pc, endp, &top);
+#ifdef LABEL_INDEX
+	if (pc >= top && pc <= bottom && is_label(l)) {
+		const unsigned int lbl = find_indexed_label(pc, l, top, bottom);
+		if (lbl != ~0u) {
+			if (lbl == 0 && errp)
+				report_err(ERR_NO_LBL);
+			return lbl;
+		}
+	}
+#endif
+	count = 1 + bottom - top;
 	while (count--) {
 		// Wrap around doesn't hurt, we just limit the search to the number of possible steps
 		// If we don't find the label, we may search a little too far if many double word
@@ -2026,6 +2411,7 @@ static void gsbgto(unsigned int pc, int gsb, unsigned int oldpc) {
 		else {
 			// Push PC on return stack
 			RetStk[--RetStkPtr] = oldpc;
+			PROFILE_CALL(pc);
 		}
 	}
 }
@@ -2303,7 +2689,15 @@ void do_conv(decNumber *r, unsigned int arg, const decNumber *x) {
 		return;
 	}
 
+#ifdef CONST_CACHE
+	if (! ConvCache[conv].valid) {
+		decimal64ToNumber(&CONSTANT_CONV(conv), &(ConvCache[conv].n));
+		ConvCache[conv].valid = 1;
+	}
+	decNumberCopy(&m, &(ConvCache[conv].n));
+#else
 	decimal64ToNumber(&CONSTANT_CONV(conv), &m);
+#endif
 
 	if (dirn == 0)		// metric to imperial
 		dn_divide(r, x, &m);
@@ -4068,9 +4462,11 @@ void XisPrime(enum nilop op) {
 		getX(&x);
 		if (decNumberIsSpecial(&x))
 			sgn = 1; // not prime
-		else if (dn_ge(&x, &const_2pow64))
-			// isPrime() reports domain error for numbers with bit 63 set
-			i = 0xFFFFFFFFFFFFFFFFull;
+		else if (dn_ge(&x, &const_2pow64)) {
+			// isPrime() covers the full 64 bit range, nothing beyond
+			report_err(ERR_DOMAIN);
+			return;
+		}
 	}
 	fin_tst(sgn == 0 && isPrime(i));
 }
@@ -5161,6 +5557,9 @@ static void multi(const opcode op) {
 void xeq(opcode op) 
 {
 	REGISTER save[STACK_SIZE+2];
+#ifdef UNDO_JOURNAL
+	struct _journal journal;
+#endif
 	const unsigned short flags = UserFlags[regA_idx >> 4];
 	const struct _ustate old = UState;
 	const unsigned char lift = get_lift();
@@ -5180,7 +5579,11 @@ void xeq(opcode op)
 	}
 #endif
 
+#ifdef UNDO_JOURNAL
+	journal_begin(&journal, save, op);
+#else
 	xcopy(save, StackBase, sizeof(save));
+#endif
 #ifdef CONSOLE
 	instruction_count++;
 #endif
@@ -5230,11 +5633,18 @@ void xeq(opcode op)
 #endif
 
 	if (Error != ERR_NONE) {
+#ifdef CONSOLE
+		last_error = Error;
+#endif
 		// deferred message (matrix code needs too much stack!)
 		error_message( Error );
 		// Repair stack and state
 		// Clear return stack
+#ifdef UNDO_JOURNAL
+		journal_restore(&journal);
+#else
 		xcopy(StackBase, save, sizeof(save));
+#endif
 		UserFlags[regA_idx >> 4] = flags;
 		UState = old;
 		State2.state_lift = lift;
@@ -5298,6 +5708,9 @@ void xeq(opcode op)
 			set_running_off();
 		}
 	} 
+#ifdef UNDO_JOURNAL
+	Journal = journal.prev;
+#endif
 	reset_volatile_state();
 #ifdef INFRARED
 	Tracing = tracing;
@@ -5310,6 +5723,7 @@ void xeq(opcode op)
 static void xeq_single(void) {
 	const opcode op = getprog(state_pc());
 
+	PROFILE_STEP(op, state_pc());
 	incpc();
 	xeq(op);
 }
@@ -22,6 +22,20 @@
  */
 #include "features.h"
 
+/*
+ * Storage class of the calculator state.  With MULTI_INSTANCE every thread
+ * has a calculator of its own, otherwise there is just the one.
+ */
+#ifdef MULTI_INSTANCE
+#ifdef _MSC_VER
+#define INSTANCE __declspec(thread)
+#else
+#define INSTANCE __thread
+#endif
+#else
+#define INSTANCE
+#endif
+
 
 /* Version number */
 #define VERSION_STRING  "3.3"
@@ -714,6 +728,9 @@ enum {
 #ifdef INCLUDE_XROM_BESSEL
         OP_BESJN, OP_BESIN, OP_BESYN, OP_BESKN,
 #endif
+#ifdef BULK_RANDOM
+        OP_MAT_RAN,
+#endif
 
         NUM_DYADIC      // Last entry defines number of operations
 };
@@ -840,6 +857,7 @@ enum nilop {
 #ifdef INCLUDE_STOPWATCH
         OP_STOPWATCH,
 #endif // INCLUDE_STOPWATCH
+        OP_DEI_NODE,
 #ifdef _DEBUG
         OP_DEBUG,
 #endif
@@ -1175,6 +1193,11 @@ extern void decpc(void);
 extern unsigned int find_opcode_from(unsigned int pc, const opcode l, const int flags);
 extern unsigned int find_label_from(unsigned int, unsigned int, int);
 extern unsigned int findmultilbl(const opcode, int);
+#ifdef LABEL_INDEX
+extern void invalidate_label_index(int region);
+#else
+#define invalidate_label_index(region)
+#endif
 extern void fin_tst(const int);
 
 extern const char *prt(opcode, char *);
@@ -1188,6 +1211,7 @@ extern void copyreg_n(int d, int s);
 extern REGISTER *get_reg_n(int);
 extern REGISTER *get_flash_reg_n(int);
 extern REGISTER *get_const(int index, int dbl);
+extern decNumber *get_const_number(decNumber *r, int index, int dbl);
 
 extern void swap_reg(REGISTER *, REGISTER *);
 extern void zero_regs(REGISTER *dest, int n);
@@ -0,0 +1,180 @@
+
+// XROM XLBL source step addresses.
+
+#ifndef XLBL_LABELS_H
+#define XLBL_LABELS_H
+
+#define XROM_2DERIV           572
+#define XROM_AGM              862
+#define XROM_Bn               2875
+#define XROM_Bn_star          2864
+#define XROM_CDFU_BINOMIAL    2097
+#define XROM_CDFU_CAUCHY      1139
+#define XROM_CDFU_CHI2        1671
+#define XROM_CDFU_EXPON       1182
+#define XROM_CDFU_F           2190
+#define XROM_CDFU_GEOM        1224
+#define XROM_CDFU_LOGIT       1295
+#define XROM_CDFU_LOGNORMAL   1341
+#define XROM_CDFU_NORMAL      1368
+#define XROM_CDFU_POIS2       1897
+#define XROM_CDFU_POISSON     1850
+#define XROM_CDFU_Q           1407
+#define XROM_CDFU_T           2311
+#define XROM_CDFU_WEIB        1570
+#define XROM_CDF_BINOMIAL     2109
+#define XROM_CDF_CAUCHY       1142
+#define XROM_CDF_CHI2         1685
+#define XROM_CDF_EXPON        1192
+#define XROM_CDF_F            2208
+#define XROM_CDF_GEOM         1236
+#define XROM_CDF_LOGIT        1303
+#define XROM_CDF_LOGNORMAL    1348
+#define XROM_CDF_NORMAL       1371
+#define XROM_CDF_POIS2        1900
+#define XROM_CDF_POISSON      1861
+#define XROM_CDF_Q            1420
+#define XROM_CDF_T            2314
+#define XROM_CDF_WEIB         1582
+#define XROM_CPX_AGM          878
+#define XROM_CPX_COMB         892
+#define XROM_CPX_FIB          2821
+#define XROM_CPX_I            2622
+#define XROM_CPX_PARL         826
+#define XROM_CPX_PERM         889
+#define XROM_CPX_W0           1010
+#define XROM_CPX_W_INVERSE    1038
+#define XROM_ChebychevTn      2488
+#define XROM_ChebychevUn      2492
+#define XROM_DATE_ADD         2668
+#define XROM_DATE_DELTA       2662
+#define XROM_DATE_TO          2655
+#define XROM_DEGREES          2702
+#define XROM_DERIV            642
+#define XROM_D_DMY            2718
+#define XROM_D_MDY            2723
+#define XROM_D_YMD            2720
+#define XROM_E3OFF            2728
+#define XROM_E3ON             2726
+#define XROM_ERF              1111
+#define XROM_ERFC             1103
+#define XROM_FIB              2810
+#define XROM_FIXENG           2750
+#define XROM_FIXSCI           2748
+#define XROM_F_DENANY         2753
+#define XROM_F_DENFAC         2758
+#define XROM_F_DENFIX         2755
+#define XROM_GRADIANS         2707
+#define XROM_HIDE_Y_REG       2767
+#define XROM_HR12             2714
+#define XROM_HR24             2716
+#define XROM_HermiteH         2534
+#define XROM_HermiteHe        2527
+#define XROM_IDIV             3215
+#define XROM_IM_LZOFF         2746
+#define XROM_IM_LZON          2744
+#define XROM_INTEGRATE        322
+#define XROM_ISGN_1C          2737
+#define XROM_ISGN_2C          2734
+#define XROM_ISGN_SM          2741
+#define XROM_ISGN_UN          2739
+#define XROM_JG1582           2710
+#define XROM_JG1752           2712
+#define XROM_LaguerreLn       2498
+#define XROM_LaguerreLnA      2502
+#define XROM_LegendrePn       2480
+#define XROM_MARGIN           846
+#define XROM_NEXTPRIME        2626
+#define XROM_PARL             816
+#define XROM_PDF_BINOMIAL     2076
+#define XROM_PDF_CAUCHY       1128
+#define XROM_PDF_CHI2         1644
+#define XROM_PDF_EXPON        1173
+#define XROM_PDF_F            2157
+#define XROM_PDF_GEOM         1212
+#define XROM_PDF_LOGIT        1284
+#define XROM_PDF_LOGNORMAL    1334
+#define XROM_PDF_NORMAL       1361
+#define XROM_PDF_POIS2        1894
+#define XROM_PDF_POISSON      1836
+#define XROM_PDF_Q            1396
+#define XROM_PDF_T            2284
+#define XROM_PDF_WEIB         1553
+#define XROM_PERCENT          834
+#define XROM_PERCHG           838
+#define XROM_PERMARGIN        856
+#define XROM_PERMMR           850
+#define XROM_PERTOT           843
+#define XROM_PRODUCT          784
+#define XROM_QF_BINOMIAL      2129
+#define XROM_QF_CAUCHY        1160
+#define XROM_QF_CHI2          1705
+#define XROM_QF_EXPON         1203
+#define XROM_QF_F             2227
+#define XROM_QF_GEOM          1256
+#define XROM_QF_LOGIT         1321
+#define XROM_QF_LOGNORMAL     1355
+#define XROM_QF_NORMAL        1385
+#define XROM_QF_POIS2         1903
+#define XROM_QF_POISSON       1875
+#define XROM_QF_Q             1435
+#define XROM_QF_T             2364
+#define XROM_QF_WEIB          1601
+#define XROM_QUAD             2832
+#define XROM_RADIANS          2704
+#define XROM_RADIX_COM        2697
+#define XROM_RADIX_DOT        2699
+#define XROM_SEPOFF           2732
+#define XROM_SEPON            2730
+#define XROM_SETCHN           2687
+#define XROM_SETEUR           2677
+#define XROM_SETIND           2685
+#define XROM_SETJAP           2690
+#define XROM_SETUK            2680
+#define XROM_SETUSA           2682
+#define XROM_SHOW_Y_REG       2765
+#define XROM_SIGMA            751
+#define XROM_SIGN             2982
+#define XROM_SOLVE            19
+#define XROM_STACK_4_LEVEL    2761
+#define XROM_STACK_8_LEVEL    2763
+#define XROM_START            1
+#define XROM_W0               910
+#define XROM_W1               916
+#define XROM_WHO              2769
+#define XROM_W_INVERSE        1034
+#define XROM_ZETA             2902
+#define XROM_beta             1042
+#define XROM_cpx_ACOS         3080
+#define XROM_cpx_ACOSH        3117
+#define XROM_cpx_ASIN         3071
+#define XROM_cpx_ASINH        3101
+#define XROM_cpx_ATAN         3086
+#define XROM_cpx_ATANH        3128
+#define XROM_cpx_CONJ         3015
+#define XROM_cpx_CROSS        3058
+#define XROM_cpx_DOT          3055
+#define XROM_cpx_EXPM1        3164
+#define XROM_cpx_FACT         3022
+#define XROM_cpx_FRAC         3004
+#define XROM_cpx_IDIV         2996
+#define XROM_cpx_LN1P         3178
+#define XROM_cpx_LOG10        3147
+#define XROM_cpx_LOG2         3151
+#define XROM_cpx_LOGXY        3140
+#define XROM_cpx_POW10        3156
+#define XROM_cpx_POW2         3159
+#define XROM_cpx_ROUND        2999
+#define XROM_cpx_SIGN         3026
+#define XROM_cpx_TRUNC        3009
+#define XROM_cpx_beta         1052
+#define XROM_cpx_gd           1079
+#define XROM_cpx_inv_gd       1093
+#define XROM_cpx_lnbeta       1062
+#define XROM_cpx_x2           3064
+#define XROM_cpx_x3           3067
+#define XROM_gd               1072
+#define XROM_int_ULP          3211
+#define XROM_inv_gd           1083
+
+#endif // XLBL_LABELS_H
@@ -0,0 +1,31 @@
+
+// XROM virtual LBL target step addresses.
+
+const unsigned short int xrom_targets[] = {
+	1924, // virtual LBL 00
+	2985, // virtual LBL 01
+	569, // virtual LBL 02
+	2613, // virtual LBL 03
+	2599, // virtual LBL 04
+	3074, // virtual LBL 05
+	1423, // virtual LBL 06
+	2606, // virtual LBL 07
+	1613, // virtual LBL 08
+	1634, // virtual LBL 09
+	1630, // virtual LBL 10
+	1623, // virtual LBL 11
+	2604, // virtual LBL 12
+	1637, // virtual LBL 13
+	1640, // virtual LBL 14
+	1642, // virtual LBL 15
+	1616, // virtual LBL 16
+	1866, // virtual LBL 17
+	2114, // virtual LBL 18
+	1502, // virtual LBL 19
+	1271, // virtual LBL 20
+	1820, // virtual LBL 21
+	1397, // virtual LBL 22
+	1421, // virtual LBL 23
+	1503  // virtual LBL 24
+}; // xrom_targets[]
+